@@ -0,0 +1,142 @@
+// ara_star.tpp - Template implementations for anytime repairing A*
+// Included at the end of maze.hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <unordered_set>
+#include <vector>
+
+template <GraphCell G>
+Path GenericMaze<G>::ara_star(Cell start, Cell dest, SearchControl& control) {
+    MAZE_TRACE_SCOPE("search", "ARA*");
+    if (start == dest) return {};
+
+    const SearchOptions& options = control.options();  // Validated by check_options
+
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    enum class State : std::uint8_t { Unseen, Open, Closed, Inconsistent };
+
+    DenseSearchState search(width, height);
+    search.trackCosts();
+    std::vector<State> state(width * height, State::Unseen);
+    std::vector<CellId> touched;  // Every cell with a finite g, so passes stay local
+    std::unordered_set<Cell> visited;  // Only kept for on_explore
+
+    // Lazy heap: an entry is live while its cell is open at the g it was pushed with
+    struct Entry {
+        float key;
+        float g;
+        CellId id;
+    };
+    struct MinKey {
+        bool operator()(const Entry& a, const Entry& b) const { return a.key > b.key; }
+    };
+    std::priority_queue<Entry, std::vector<Entry>, MinKey> open;
+
+    const CellId goal_id = search.id(dest);
+    auto h = [&](Cell cell) { return estimate(options.heuristic, cell, dest); };
+    auto live = [&](const Entry& entry) {
+        return state[entry.id.index] == State::Open && entry.g == search.cost(entry.id);
+    };
+
+    // One weighted A* pass; closed cells that improve wait for the next pass
+    // instead of being reopened. False if the budget ran out.
+    auto improve = [&](float weight) {
+        while (true) {
+            while (!open.empty() && !live(open.top())) open.pop();
+            if (open.empty() || search.cost(goal_id) <= open.top().key) return true;
+
+            const CellId id = open.top().id;
+            const Cell cell = search.cell(id);
+            open.pop();
+            state[id.index] = State::Closed;
+            if (options.on_explore) visited.insert(cell);
+            if (!control.expand(cell)) return false;
+
+            if (options.on_explore) {
+                std::vector<Cell> frontier;
+                frontier.reserve(open.size());
+                auto temp = open;
+                while (!temp.empty()) {
+                    if (live(temp.top())) frontier.push_back(search.cell(temp.top().id));
+                    temp.pop();
+                }
+                options.on_explore(cell, frontier, visited);
+            }
+
+            for (std::uint8_t di = 0; di < Direction::COUNT; ++di) {
+                Direction dir = static_cast<Direction>(di);
+                if (!cell.hasDir(dir, width, height)) continue;
+
+                Cell neighbor = cell.toward(dir);
+                const G& data = cell_at(neighbor);
+                if (data.wall) continue;
+
+                const CellId next = search.id(neighbor);
+                float cost = search.cost(id) + data.weight;
+                float& next_g = search.cost(next);
+                if (cost >= next_g) continue;
+                if (next_g == inf) touched.push_back(next);
+                next_g = cost;
+                search.dir(next) = dir;
+
+                State& next_state = state[next.index];
+                if (next_state == State::Closed) {
+                    next_state = State::Inconsistent;
+                } else if (next_state != State::Inconsistent) {
+                    next_state = State::Open;
+                    open.push({cost + weight * h(neighbor), cost, next});
+                }
+            }
+        }
+    };
+
+    float weight = options.initial_weight;
+    const CellId start_id = search.id(start);
+    search.cost(start_id) = 0.0f;
+    search.dir(start_id) = Direction::COUNT;
+    state[start_id.index] = State::Open;
+    touched.push_back(start_id);
+    open.push({weight * h(start), 0.0f, start_id});
+
+    Path best_path;
+    while (improve(weight)) {
+        const float goal = search.cost(goal_id);
+        if (goal == inf) return {};
+        best_path = trace_path(search, start, dest);
+
+        // Suboptimality bound: the goal's cost against the cheapest unexpanded estimate
+        float lower = inf;
+        for (CellId id : touched) {
+            State s = state[id.index];
+            if (s == State::Open || s == State::Inconsistent) {
+                lower = std::min(lower, search.cost(id) + h(search.cell(id)));
+            }
+        }
+        float bound = std::max(1.0f, std::min(weight, goal / lower));
+        control.setBound(bound);
+        if (bound <= 1.0f) return best_path;
+
+        // Next pass: lower the weight, reopen the inconsistent cells and rekey the heap
+        weight = std::max(1.0f, weight - options.weight_step);
+        std::vector<Entry> entries;
+        for (CellId id : touched) {
+            State& s = state[id.index];
+            if (s == State::Closed) {
+                s = State::Unseen;
+            } else if (s != State::Unseen) {
+                s = State::Open;
+                float g = search.cost(id);
+                entries.push_back({g + weight * h(search.cell(id)), g, id});
+            }
+        }
+        open = decltype(open)(MinKey{}, std::move(entries));
+    }
+
+    // Interrupted: keep the last complete path, else head toward the goal
+    if (!best_path.empty()) return best_path;
+    return trace_path(search, start, *control.best());
+}
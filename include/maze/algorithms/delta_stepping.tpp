@@ -0,0 +1,247 @@
+// delta_stepping.tpp - Template implementations for parallel Δ-stepping
+// Included at the end of maze.hpp
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "maze/core/parallel.hpp"
+
+namespace delta_stepping_detail {
+
+/// @brief Pack a non-negative cost and the direction it arrived from into one word,
+/// so the pair can be swapped with one CAS. Non-negative IEEE floats order like
+/// their bit patterns, so the high half compares like the cost.
+inline std::uint64_t pack(float cost, Direction dir) {
+    return (static_cast<std::uint64_t>(std::bit_cast<std::uint32_t>(cost)) << 32)
+        | static_cast<std::uint32_t>(dir);
+}
+
+inline float cost_of(std::uint64_t packed) {
+    return std::bit_cast<float>(static_cast<std::uint32_t>(packed >> 32));
+}
+
+inline Direction dir_of(std::uint64_t packed) {
+    return static_cast<Direction>(packed & 0xFFFFFFFFu);
+}
+
+}  // namespace delta_stepping_detail
+
+template <GraphCell G>
+void GenericMaze<G>::delta_stepping(Cell source, std::optional<Cell> dest,
+    SearchControl& control, std::vector<std::atomic<std::uint64_t>>& best) const {
+    using namespace delta_stepping_detail;
+    const SearchOptions& options = control.options();
+    constexpr std::uint32_t npos = UINT32_MAX;
+
+    const std::size_t cells = width * height;
+    if (cells >= npos) throw std::length_error("Maze too large for Delta-stepping");
+
+    float max_weight = 0.0f;
+    for (std::size_t row = 0; row < height; ++row) {
+        for (std::size_t col = 0; col < width; ++col) {
+            const G& cell = grid[row][col];
+            if (!cell.wall) max_weight = std::max<float>(max_weight, cell.weight);
+        }
+    }
+    float delta = options.delta;
+    if (delta <= 0.0f) delta = max_weight > 0.0f ? max_weight : 1.0f;
+    const bool has_heavy = max_weight > delta;
+
+    const std::uint64_t unreached =
+        pack(std::numeric_limits<float>::infinity(), Direction::COUNT);
+    for (auto& slot : best) slot.store(unreached, std::memory_order_relaxed);
+
+    auto index_of = [this](Cell cell) {
+        return static_cast<std::uint32_t>(cell.row * width + cell.col);
+    };
+    auto bucket_of = [delta](float cost) {
+        return static_cast<std::size_t>(cost / delta);
+    };
+
+    const std::size_t threads = resolve_threads(options.threads);
+    std::vector<std::vector<std::uint32_t>> buckets(1);
+    std::vector<std::uint32_t> queued(cells, npos);  // Bucket each cell currently sits in
+    std::vector<std::vector<std::uint32_t>> outboxes(threads);
+    std::vector<std::uint32_t> work;
+    std::vector<std::uint32_t> settled;  // Cells removed from the current bucket
+    std::unordered_set<Cell> visited;
+    std::size_t current = 0;
+
+    enum class Phase { Light, Heavy, Done };
+    Phase phase = Phase::Light;
+
+    best[index_of(source)].store(pack(0.0f, Direction::COUNT), std::memory_order_relaxed);
+    buckets[0].push_back(index_of(source));
+    queued[index_of(source)] = 0;
+
+    auto enqueue = [&](std::uint32_t index) {
+        std::size_t bucket = bucket_of(cost_of(best[index].load(std::memory_order_relaxed)));
+        if (queued[index] == bucket) return;
+        if (bucket >= buckets.size()) buckets.resize(bucket + 1);
+        buckets[bucket].push_back(index);
+        queued[index] = static_cast<std::uint32_t>(bucket);
+    };
+
+    // Take the live entries of the current bucket as the next light phase;
+    // false if the search budget ran out while taking them
+    auto take_current = [&] {
+        work.clear();
+        if (current >= buckets.size()) return true;
+        std::vector<std::uint32_t> pending;
+        pending.swap(buckets[current]);
+        for (std::uint32_t index : pending) {
+            if (queued[index] != current) continue;  // Moved to a cheaper bucket
+            queued[index] = npos;
+            work.push_back(index);
+            settled.push_back(index);
+            if (!control.expand({index / width, index % width})) return false;
+        }
+        return true;
+    };
+
+    // Serial step between parallel phases: route requests, pick the next phase
+    auto step = [&]() noexcept {
+        for (auto& outbox : outboxes) {
+            for (std::uint32_t index : outbox) enqueue(index);
+            outbox.clear();
+        }
+
+        if (phase == Phase::Light) {
+            if (!take_current()) {
+                phase = Phase::Done;
+                return;
+            }
+            if (!work.empty()) {
+                if (options.on_explore) {
+                    std::vector<Cell> frontier;
+                    frontier.reserve(work.size());
+                    for (std::uint32_t index : work) {
+                        frontier.push_back({index / width, index % width});
+                        visited.insert(frontier.back());
+                    }
+                    options.on_explore(frontier.front(), frontier, visited);
+                }
+                return;
+            }
+            if (has_heavy && !settled.empty()) {
+                phase = Phase::Heavy;
+                work.swap(settled);
+                settled.clear();
+                return;
+            }
+        }
+
+        // Current bucket is final; advance to the next non-empty one
+        settled.clear();
+        phase = Phase::Light;
+        do {
+            ++current;
+        } while (current < buckets.size() && buckets[current].empty());
+
+        if (dest) {
+            float reached = cost_of(best[index_of(*dest)].load(std::memory_order_relaxed));
+            if (std::isfinite(reached) && bucket_of(reached) < current) {
+                current = buckets.size();
+            }
+        }
+        if (current >= buckets.size() || !take_current()) phase = Phase::Done;
+    };
+
+    // Only a strictly cheaper cost may replace a predecessor. Comparing whole
+    // words would let an equal cost with a smaller direction re-point cells
+    // behind zero-weight steps into a cycle.
+    auto relax = [&](std::uint32_t index, std::uint64_t candidate) {
+        std::uint64_t seen = best[index].load(std::memory_order_relaxed);
+        while (cost_of(candidate) < cost_of(seen)) {
+            if (best[index].compare_exchange_weak(seen, candidate, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::barrier sync(static_cast<std::ptrdiff_t>(threads), step);
+    auto worker = [&](std::size_t id) {
+        while (true) {
+            sync.arrive_and_wait();
+            if (phase == Phase::Done) return;
+
+            const bool heavy = phase == Phase::Heavy;
+            const std::size_t begin = id * work.size() / threads;
+            const std::size_t end = (id + 1) * work.size() / threads;
+            for (std::size_t i = begin; i < end; ++i) {
+                std::uint32_t index = work[i];
+                Cell cell{index / width, index % width};
+                float cost = cost_of(best[index].load(std::memory_order_relaxed));
+
+                for (std::uint8_t di = 0; di < Direction::COUNT; ++di) {
+                    Direction dir = static_cast<Direction>(di);
+                    if (!cell.hasDir(dir, width, height)) continue;
+                    Cell neighbor = cell.toward(dir);
+                    const G& data = grid[neighbor.row][neighbor.col];
+                    if (data.wall || (data.weight > delta) != heavy) continue;
+
+                    std::uint32_t target = index_of(neighbor);
+                    if (relax(target, pack(cost + data.weight, dir))) {
+                        outboxes[id].push_back(target);
+                    }
+                }
+            }
+        }
+    };
+
+    run_team(threads, worker);
+}
+
+template <GraphCell G>
+std::vector<float> GenericMaze<G>::costMap(Cell source, std::size_t threads, float delta) const {
+    if (source.row >= height || source.col >= width) {
+        throw std::out_of_range("Cell (" + std::to_string(source.row) + ", "
+            + std::to_string(source.col) + ") out of bounds for maze of size "
+            + std::to_string(width) + "x" + std::to_string(height));
+    }
+    SearchOptions options;
+    options.threads = threads;
+    options.delta = delta;
+    SearchControl control(options, std::nullopt);
+    std::vector<std::atomic<std::uint64_t>> best(width * height);
+    delta_stepping(source, std::nullopt, control, best);
+
+    std::vector<float> costs(best.size());
+    for (std::size_t i = 0; i < best.size(); ++i) {
+        costs[i] = delta_stepping_detail::cost_of(best[i].load(std::memory_order_relaxed));
+    }
+    return costs;
+}
+
+template <GraphCell G>
+Path GenericMaze<G>::delta_stepping_path(Cell start, Cell dest, SearchControl& control) {
+    MAZE_TRACE_SCOPE("search", "Delta-stepping");
+    std::vector<std::atomic<std::uint64_t>> best(width * height);
+    delta_stepping(start, dest, control, best);
+
+    // An interrupted run still has a consistent tree: every finite cost points
+    // back along no costlier cells, without cycles, to the source
+    Path result;
+    Cell current = control.stopReason() ? *control.best() : dest;
+    std::uint64_t packed = best[current.row * width + current.col].load(std::memory_order_relaxed);
+    if (!std::isfinite(delta_stepping_detail::cost_of(packed))) return {};
+    while (!(current == start)) {
+        Direction dir = delta_stepping_detail::dir_of(
+            best[current.row * width + current.col].load(std::memory_order_relaxed));
+        result.push_back(dir);
+        current.move(reverse(dir));
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
@@ -0,0 +1,106 @@
+// distance_matrix.tpp - Template implementations for many-to-many distance matrices
+// Included at the end of maze.hpp
+
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "maze/core/parallel.hpp"
+
+template <GraphCell G>
+DistanceMatrix GenericMaze<G>::distanceMatrix(const std::vector<Cell>& points,
+    std::size_t threads, bool keep_paths) const {
+    for (const Cell& point : points) at(point);  // Bounds checks
+    MAZE_TRACE_SCOPE("search", "Distance matrix");
+
+    constexpr float kUnreached = std::numeric_limits<float>::infinity();
+    const std::size_t count = points.size();
+    const std::size_t cells = width * height;
+    DistanceMatrix matrix;
+    matrix.width_ = width;
+    matrix.cells_ = cells;
+    matrix.points_ = points;
+    matrix.costs_.assign(count * count, kUnreached);
+    if (keep_paths) matrix.parents_.assign(count * cells, Direction::COUNT);
+
+    // Points may repeat; each search only has to settle every distinct one.
+    // No search ever settles a wall, so wall points are not waited for.
+    std::vector<std::uint8_t> is_point(cells, 0);
+    std::vector<Cell> distinct;
+    for (const Cell& point : points) {
+        if (cell_at(point).wall) continue;
+        std::uint8_t& mark = is_point[point.row * width + point.col];
+        if (!mark) distinct.push_back(point);
+        mark = 1;
+    }
+
+    // How many distinct points each search can reach; walls reach none. With
+    // component tracking, points in other regions need not be waited for.
+    // Labels refresh here, on the calling thread, before any worker starts.
+    std::vector<std::size_t> reachable(count, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (cell_at(points[i]).wall) continue;
+        if (!components_) {
+            reachable[i] = distinct.size();
+            continue;
+        }
+        for (const Cell& point : distinct) {
+            if (point == points[i] || connected(points[i], point)) ++reachable[i];
+        }
+    }
+
+    parallel_for(count, threads, [&](std::size_t i) {
+        MAZE_TRACE_SCOPE("search", "Distance matrix row");
+        if (reachable[i] == 0) return;  // A wall: its row stays infinite, diagonal included
+        const Cell source = points[i];
+        std::vector<float> dist(cells, kUnreached);
+        Direction* parents = keep_paths ? matrix.parents_.data() + i * cells : nullptr;
+
+        using PQEntry = std::pair<float, CellId>;
+        struct MinCost {
+            bool operator()(const PQEntry& a, const PQEntry& b) const {
+                return a.first > b.first;
+            }
+        };
+        std::priority_queue<PQEntry, std::vector<PQEntry>, MinCost> pq;
+
+        const CellId source_id = CellId::from(source, width);
+        dist[source_id.index] = 0.0f;
+        pq.emplace(0.0f, source_id);
+
+        std::size_t remaining = reachable[i];
+        while (!pq.empty()) {
+            auto [d, id] = pq.top();
+            pq.pop();
+            if (d > dist[id.index]) continue;
+            if (is_point[id.index] && --remaining == 0) break;
+            Cell cell = id.toCell(width);
+
+            for (std::uint8_t di = 0; di < Direction::COUNT; ++di) {
+                Direction dir = static_cast<Direction>(di);
+                if (!cell.hasDir(dir, width, height)) continue;
+
+                Cell neighbor = cell.toward(dir);
+                const G& neighbor_data = cell_at(neighbor);
+                if (neighbor_data.wall) continue;
+
+                CellId neighbor_id = CellId::from(neighbor, width);
+                float new_dist = d + neighbor_data.weight;
+                float& best = dist[neighbor_id.index];
+                if (new_dist < best) {
+                    best = new_dist;
+                    if (parents) parents[neighbor_id.index] = dir;
+                    pq.emplace(new_dist, neighbor_id);
+                }
+            }
+        }
+
+        // Each worker writes only its own row
+        for (std::size_t j = 0; j < count; ++j) {
+            matrix.costs_[i * count + j] = dist[points[j].row * width + points[j].col];
+        }
+    });
+    return matrix;
+}
@@ -2,11 +2,13 @@
 // Included at the end of maze.hpp
 
 #include <vector>
+#include <cstdint>
 #include <random>
 #include <algorithm>
 
 template <GraphCell G>
 void GenericMaze<G>::fill(const G& cell) {
+    invalidate();
     for (std::size_t row = 0; row < height; ++row) {
         for (std::size_t col = 0; col < width; ++col) {
             grid[row][col] = cell;
@@ -16,7 +18,14 @@ void GenericMaze<G>::fill(const G& cell) {
 
 template <GraphCell G>
 void GenericMaze<G>::generate(GenerationAlgorithm algorithm, const G& wall, const G& passage) {
-    std::mt19937 rng(std::random_device{}());
+    std::random_device device;
+    generate(algorithm, wall, passage, (std::uint64_t{device()} << 32) | device());
+}
+
+template <GraphCell G>
+void GenericMaze<G>::generate(GenerationAlgorithm algorithm, const G& wall, const G& passage,
+    std::uint64_t seed) {
+    CounterRng rng(seed);
     switch (algorithm) {
         case GenerationAlgorithm::RecursiveBacktracker:
             generate_recursive_backtracker(wall, passage, rng);
@@ -32,7 +41,7 @@ void GenericMaze<G>::generate(GenerationAlgorithm algorithm, const G& wall, cons
 
 template <GraphCell G>
 void GenericMaze<G>::generate_recursive_backtracker(const G& wall, const G& passage,
-    std::mt19937& rng) {
+    CounterRng& rng) {
     fill(wall);
 
     const std::size_t node_rows = (height - 1) / 2;
@@ -47,10 +56,8 @@ void GenericMaze<G>::generate_recursive_backtracker(const G& wall, const G& pass
     };
 
     std::vector<bool> visited(node_rows * node_cols, false);
-    std::uniform_int_distribution<std::size_t> row_dist(0, node_rows - 1);
-    std::uniform_int_distribution<std::size_t> col_dist(0, node_cols - 1);
-
-    Cell start{row_dist(rng) * 2 + 1, col_dist(rng) * 2 + 1};
+    Cell start{static_cast<std::size_t>(rng.bounded(node_rows)) * 2 + 1,
+        static_cast<std::size_t>(rng.bounded(node_cols)) * 2 + 1};
     visited[node_index(start)] = true;
     at_unchecked(start) = passage;
 
@@ -80,8 +87,7 @@ void GenericMaze<G>::generate_recursive_backtracker(const G& wall, const G& pass
             continue;
         }
 
-        std::uniform_int_distribution<std::size_t> pick(0, neighbors.size() - 1);
-        Cell neighbor = neighbors[pick(rng)];
+        Cell neighbor = neighbors[rng.bounded(neighbors.size())];
 
         Cell between{
             (current.row + neighbor.row) / 2,
@@ -96,7 +102,7 @@ void GenericMaze<G>::generate_recursive_backtracker(const G& wall, const G& pass
 
 template <GraphCell G>
 void GenericMaze<G>::generate_prim(const G& wall, const G& passage,
-    std::mt19937& rng) {
+    CounterRng& rng) {
     fill(wall);
 
     const std::size_t node_rows = (height - 1) / 2;
@@ -116,10 +122,8 @@ void GenericMaze<G>::generate_prim(const G& wall, const G& passage,
     };
 
     std::vector<bool> visited(node_rows * node_cols, false);
-    std::uniform_int_distribution<std::size_t> row_dist(0, node_rows - 1);
-    std::uniform_int_distribution<std::size_t> col_dist(0, node_cols - 1);
-
-    Cell start{row_dist(rng) * 2 + 1, col_dist(rng) * 2 + 1};
+    Cell start{static_cast<std::size_t>(rng.bounded(node_rows)) * 2 + 1,
+        static_cast<std::size_t>(rng.bounded(node_cols)) * 2 + 1};
     visited[node_index(start)] = true;
     at_unchecked(start) = passage;
 
@@ -142,8 +146,7 @@ void GenericMaze<G>::generate_prim(const G& wall, const G& passage,
     add_frontier(start);
 
     while (!frontier.empty()) {
-        std::uniform_int_distribution<std::size_t> pick(0, frontier.size() - 1);
-        std::size_t idx = pick(rng);
+        std::size_t idx = rng.bounded(frontier.size());
         FrontierEdge edge = frontier[idx];
         frontier[idx] = frontier.back();
         frontier.pop_back();
@@ -165,7 +168,7 @@ void GenericMaze<G>::generate_prim(const G& wall, const G& passage,
 
 template <GraphCell G>
 void GenericMaze<G>::generate_kruskal(const G& wall, const G& passage,
-    std::mt19937& rng) {
+    CounterRng& rng) {
     fill(wall);
 
     const std::size_t node_rows = (height - 1) / 2;
@@ -200,7 +203,7 @@ void GenericMaze<G>::generate_kruskal(const G& wall, const G& passage,
         }
     }
 
-    std::shuffle(edges.begin(), edges.end(), rng);
+    rng.shuffle(edges.begin(), edges.end());
 
     struct DisjointSet {
         std::vector<std::size_t> parent;
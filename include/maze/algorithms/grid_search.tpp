@@ -0,0 +1,197 @@
+// grid_search.tpp - Search engines shared by every CellSource
+// Included at the end of maze.hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/// @brief Per-query search state for stored grids: one byte of predecessor
+/// per cell, plus a dense cost array for the cost-ordered engines.
+class DenseSearchState {
+public:
+    using Id = CellId;
+
+    DenseSearchState(std::size_t width, std::size_t height)
+        : width_(width), height_(height), dirs_(width, height) {}
+
+    Id id(Cell cell) const { return CellId::from(cell, width_); }
+    Cell cell(Id id) const { return id.toCell(width_); }
+
+    /// @brief True once the search has stored a predecessor for the cell.
+    bool reached(Id id) const { return dirs_.contains(id); }
+    Direction& dir(Id id) { return dirs_[id]; }
+
+    /// @brief Allocate path costs; every cell starts at infinity.
+    void trackCosts() { costs_.assign(width_ * height_, std::numeric_limits<float>::infinity()); }
+    /// @brief Best known cost to the cell; requires trackCosts.
+    float& cost(Id id) { return costs_[id.index]; }
+
+private:
+    std::size_t width_, height_;
+    DirectionMap dirs_;
+    std::vector<float> costs_;
+};
+
+/// @brief Per-query search state for sources too large to index densely;
+/// memory grows with the explored area.
+class SparseSearchState {
+public:
+    using Id = WideCellId;
+
+    explicit SparseSearchState(std::size_t width) : width_(width) {}
+
+    Id id(Cell cell) const { return WideCellId::from(cell, width_); }
+    Cell cell(Id id) const { return id.toCell(width_); }
+
+    bool reached(Id id) const { return dirs_.contains(id); }
+    Direction& dir(Id id) { return dirs_[id]; }
+
+    void trackCosts() {}
+    float& cost(Id id) {
+        return costs_.try_emplace(id, std::numeric_limits<float>::infinity()).first->second;
+    }
+
+private:
+    std::size_t width_;
+    std::unordered_map<Id, Direction> dirs_;
+    std::unordered_map<Id, float> costs_;
+};
+
+/// @brief Follow predecessor directions back from `end` to `start`.
+template <typename State>
+Path trace_path(State& state, Cell start, Cell end) {
+    Path result;
+    while (!(end == start)) {
+        Direction dir = state.dir(state.id(end));
+        result.push_back(dir);
+        end.move(reverse(dir));
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+/// @brief Breadth-first search over any cell source.
+/// @param state Dense or sparse per-query storage (DenseSearchState, SparseSearchState).
+/// @return The path, or after an interruption the path to the best cell reached.
+template <CellSource S, typename State>
+Path grid_bfs(const S& source, Cell start, Cell dest, SearchControl& control, State& state) {
+    using Id = typename State::Id;
+    const SearchOptions& options = control.options();
+    const std::size_t width = source.getWidth();
+    const std::size_t height = source.getHeight();
+    const Id dest_id = state.id(dest);
+    std::unordered_set<Cell> visited;  // Only kept for on_explore
+    std::queue<Id> queue;
+
+    state.dir(state.id(start)) = Direction::COUNT;
+    queue.push(state.id(start));
+    if (options.on_explore) visited.insert(start);
+
+    while (!queue.empty()) {
+        Id id = queue.front();
+        queue.pop();
+        Cell cell = state.cell(id);
+        if (!control.expand(cell)) return trace_path(state, start, *control.best());
+        if (options.on_explore) {
+            std::vector<Cell> frontier;
+            frontier.reserve(queue.size());
+            auto temp = queue;
+            while (!temp.empty()) {
+                frontier.push_back(state.cell(temp.front()));
+                temp.pop();
+            }
+            options.on_explore(cell, frontier, visited);
+        }
+        if (id == dest_id) return trace_path(state, start, dest);
+
+        for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
+            Direction dir = static_cast<Direction>(d);
+            if (!cell.hasDir(dir, width, height)) continue;
+            Cell next = cell.toward(dir);
+            Id next_id = state.id(next);
+            if (source.at_unchecked(next).wall || state.reached(next_id)) continue;
+            state.dir(next_id) = dir;
+            queue.push(next_id);
+            if (options.on_explore) visited.insert(next);
+        }
+    }
+    return {};
+}
+
+/// @brief A* search over any cell source.
+/// @param state Dense or sparse per-query storage (DenseSearchState, SparseSearchState).
+/// @param estimate Admissible cost estimate, called as estimate(from, to).
+template <CellSource S, typename State, typename Estimate>
+Path grid_a_star(const S& source, Cell start, Cell dest, SearchControl& control,
+    State& state, Estimate&& estimate) {
+    if (start == dest) return {};
+
+    using Id = typename State::Id;
+    const SearchOptions& options = control.options();
+    const std::size_t width = source.getWidth();
+    const std::size_t height = source.getHeight();
+    const Id dest_id = state.id(dest);
+    std::unordered_set<Cell> visited;  // Only kept for on_explore
+
+    using PQEntry = std::pair<float, Id>;
+    struct MinCost {
+        bool operator()(const PQEntry& a, const PQEntry& b) const {
+            return a.first > b.first;
+        }
+    };
+    std::priority_queue<PQEntry, std::vector<PQEntry>, MinCost> pq;
+
+    state.trackCosts();
+    state.cost(state.id(start)) = 0.0f;
+    state.dir(state.id(start)) = Direction::COUNT;
+    pq.emplace(estimate(start, dest), state.id(start));
+
+    while (!pq.empty()) {
+        auto [f_score, id] = pq.top();
+        pq.pop();
+
+        if (id == dest_id) return trace_path(state, start, dest);
+
+        Cell cell = state.cell(id);
+        const float g = state.cost(id);
+        if (f_score > g + estimate(cell, dest)) continue;  // Stale entry
+        if (options.on_explore) visited.insert(cell);
+        if (!control.expand(cell)) return trace_path(state, start, *control.best());
+
+        if (options.on_explore) {
+            std::vector<Cell> frontier;
+            frontier.reserve(pq.size());
+            auto temp = pq;
+            while (!temp.empty()) {
+                frontier.push_back(state.cell(temp.top().second));
+                temp.pop();
+            }
+            options.on_explore(cell, frontier, visited);
+        }
+
+        for (std::uint8_t di = 0; di < Direction::COUNT; ++di) {
+            Direction dir = static_cast<Direction>(di);
+            if (!cell.hasDir(dir, width, height)) continue;
+
+            Cell neighbor = cell.toward(dir);
+            const auto& neighbor_data = source.at_unchecked(neighbor);
+            if (neighbor_data.wall) continue;
+
+            Id neighbor_id = state.id(neighbor);
+            float tentative_g = g + neighbor_data.weight;
+            float& neighbor_g = state.cost(neighbor_id);
+            if (tentative_g < neighbor_g) {
+                neighbor_g = tentative_g;
+                state.dir(neighbor_id) = dir;
+                pq.emplace(tentative_g + estimate(neighbor, dest), neighbor_id);
+            }
+        }
+    }
+    return {};
+}
@@ -0,0 +1,96 @@
+// landmarks.tpp - Template implementations for ALT landmark tables
+// Included at the end of maze.hpp
+
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "maze/core/parallel.hpp"
+
+template <GraphCell G>
+void GenericMaze<G>::buildLandmarks(std::size_t count, std::size_t threads) {
+    auto table = std::make_shared<LandmarkTable>();
+    table->width = width;
+    table->height = height;
+    table->fingerprint = fingerprint();
+
+    // Spread anchors evenly around the border, then snap each one to the
+    // nearest passage; peripheral landmarks give the tightest bounds
+    const std::size_t perimeter = 2 * (width + height);
+    auto border_point = [&](std::size_t offset) -> Cell {
+        if (offset < width) return {0, offset};
+        offset -= width;
+        if (offset < height) return {offset, width - 1};
+        offset -= height;
+        if (offset < width) return {height - 1, width - 1 - offset};
+        offset -= width;
+        return {height - 1 - offset, 0};
+    };
+    auto nearest_passage = [&](Cell anchor) -> std::optional<Cell> {
+        const std::size_t reach = std::max(width, height);
+        for (std::size_t radius = 0; radius < reach; ++radius) {
+            std::size_t r0 = anchor.row > radius ? anchor.row - radius : 0;
+            std::size_t c0 = anchor.col > radius ? anchor.col - radius : 0;
+            std::size_t r1 = std::min(height - 1, anchor.row + radius);
+            std::size_t c1 = std::min(width - 1, anchor.col + radius);
+            for (std::size_t r = r0; r <= r1; ++r) {
+                for (std::size_t c = c0; c <= c1; ++c) {
+                    if (!cell_at({r, c}).wall) return Cell{r, c};
+                }
+            }
+        }
+        return std::nullopt;
+    };
+
+    for (std::size_t i = 0; i < count; ++i) {
+        auto cell = nearest_passage(border_point(i * perimeter / count));
+        if (!cell) break;  // No passages at all
+        if (std::find(table->landmarks.begin(), table->landmarks.end(), *cell)
+            == table->landmarks.end()) {
+            table->landmarks.push_back(*cell);
+        }
+    }
+
+    const std::size_t cells = width * height;
+    table->distances.resize(table->landmarks.size() * cells);
+    parallel_for(table->landmarks.size(), threads, [&](std::size_t i) {
+        std::vector<float> dist = distances_from(table->landmarks[i]);
+        std::copy(dist.begin(), dist.end(),
+            table->distances.begin() + static_cast<std::ptrdiff_t>(i * cells));
+    });
+
+    landmarks_ = std::move(table);
+}
+
+template <GraphCell G>
+void GenericMaze<G>::setLandmarks(std::shared_ptr<const LandmarkTable> table) {
+    if (table && (table->width != width || table->height != height
+        || table->fingerprint != fingerprint())) {
+        throw std::invalid_argument("Landmark table was built for a different maze");
+    }
+    landmarks_ = std::move(table);
+}
+
+template <GraphCell G>
+std::uint64_t GenericMaze<G>::fingerprint() const {
+    // FNV-1a over the dimensions and every cell's passability and weight
+    std::uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](std::uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (8 * i)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(width);
+    mix(height);
+    for (std::size_t row = 0; row < height; ++row) {
+        for (std::size_t col = 0; col < width; ++col) {
+            const G& cell = grid[row][col];
+            mix(cell.wall ? 1 : std::bit_cast<std::uint32_t>(static_cast<float>(cell.weight)));
+        }
+    }
+    return hash;
+}
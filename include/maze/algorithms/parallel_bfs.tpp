@@ -0,0 +1,216 @@
+// parallel_bfs.tpp - Template implementations for direction-optimizing parallel BFS
+// Included at the end of maze.hpp
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "maze/core/parallel.hpp"
+
+template <GraphCell G>
+void GenericMaze<G>::parallel_bfs(Cell source, std::optional<Cell> dest,
+    SearchControl& control, std::vector<std::uint32_t>& level) const {
+    const SearchOptions& options = control.options();
+    constexpr std::uint32_t unreached = std::numeric_limits<std::uint32_t>::max();
+    // Beamer et al.: go bottom-up once the frontier's edges outweigh 1/alpha of
+    // the unexplored edges, return top-down when the frontier shrinks below n/beta
+    constexpr std::size_t kAlpha = 14;
+    constexpr std::size_t kBeta = 24;
+
+    const std::size_t cells = width * height;
+    if (cells >= unreached) throw std::length_error("Maze too large for parallel BFS");
+    const std::size_t words = (cells + 63) / 64;
+    const std::size_t threads = resolve_threads(options.threads);
+
+    auto index_of = [this](Cell cell) {
+        return static_cast<std::uint32_t>(cell.row * width + cell.col);
+    };
+
+    // Walls start out "visited" so neither direction ever expands into them
+    std::vector<std::atomic<std::uint64_t>> visited(words);
+    std::vector<std::uint64_t> in_frontier(words, 0);
+    std::size_t unexplored = 0;
+    for (std::size_t word = 0; word < words; ++word) {
+        std::uint64_t bits = 0;
+        for (std::size_t i = word * 64; i < std::min(cells, word * 64 + 64); ++i) {
+            if (grid[i / width][i % width].wall) {
+                bits |= std::uint64_t{1} << (i % 64);
+            } else {
+                ++unexplored;
+            }
+        }
+        if (word == words - 1 && cells % 64 != 0) bits |= ~std::uint64_t{0} << (cells % 64);
+        visited[word].store(bits, std::memory_order_relaxed);
+    }
+
+    level.assign(cells, unreached);
+    std::uint32_t src = index_of(source);
+    level[src] = 0;
+    visited[src / 64].fetch_or(std::uint64_t{1} << (src % 64), std::memory_order_relaxed);
+    --unexplored;
+
+    std::vector<std::uint32_t> frontier{src};
+    std::vector<std::vector<std::uint32_t>> next(threads);
+    std::unordered_set<Cell> seen;
+    std::uint32_t depth = 0;
+    bool bottom_up = false;
+    bool done = false;
+
+    auto claim = [&](std::uint32_t index) {
+        std::uint64_t bit = std::uint64_t{1} << (index % 64);
+        return (visited[index / 64].fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+    };
+
+    // Serial step between levels: gather the next frontier and pick a direction
+    auto step = [&]() noexcept {
+        for (std::uint32_t index : frontier) in_frontier[index / 64] = 0;
+        if (depth > 0) {
+            frontier.clear();
+            for (auto& local : next) {
+                frontier.insert(frontier.end(), local.begin(), local.end());
+                local.clear();
+            }
+            unexplored -= frontier.size();
+        }
+
+        if (frontier.empty() || (dest && level[index_of(*dest)] != unreached)) {
+            done = true;
+            return;
+        }
+
+        for (std::uint32_t index : frontier) {
+            if (!control.expand({index / width, index % width})) {
+                done = true;
+                return;
+            }
+        }
+        if (options.on_explore) {
+            std::vector<Cell> cells_at_level;
+            cells_at_level.reserve(frontier.size());
+            for (std::uint32_t index : frontier) {
+                cells_at_level.push_back({index / width, index % width});
+                seen.insert(cells_at_level.back());
+            }
+            options.on_explore(cells_at_level.front(), cells_at_level, seen);
+        }
+
+        if (!bottom_up && frontier.size() * kAlpha > unexplored) {
+            bottom_up = true;
+        } else if (bottom_up && frontier.size() * kBeta < cells) {
+            bottom_up = false;
+        }
+        if (bottom_up) {
+            for (std::uint32_t index : frontier) {
+                in_frontier[index / 64] |= std::uint64_t{1} << (index % 64);
+            }
+        }
+        ++depth;
+    };
+
+    auto in_last_level = [&](std::uint32_t index) {
+        return (in_frontier[index / 64] >> (index % 64)) & 1;
+    };
+
+    std::barrier sync(static_cast<std::ptrdiff_t>(threads), step);
+    auto worker = [&](std::size_t id) {
+        while (true) {
+            sync.arrive_and_wait();
+            if (done) return;
+            auto& out = next[id];
+
+            if (!bottom_up) {
+                // Top-down: push from the frontier, claiming cells with an atomic or
+                const std::size_t begin = id * frontier.size() / threads;
+                const std::size_t end = (id + 1) * frontier.size() / threads;
+                for (std::size_t i = begin; i < end; ++i) {
+                    Cell cell{frontier[i] / width, frontier[i] % width};
+                    for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
+                        Direction dir = static_cast<Direction>(d);
+                        if (!cell.hasDir(dir, width, height)) continue;
+                        std::uint32_t neighbor = index_of(cell.toward(dir));
+                        if (claim(neighbor)) {
+                            level[neighbor] = depth;
+                            out.push_back(neighbor);
+                        }
+                    }
+                }
+            } else {
+                // Bottom-up: each unvisited cell looks for a parent in the frontier.
+                // Threads own whole bitmap words, so no two claim the same cell.
+                const std::size_t begin = id * words / threads;
+                const std::size_t end = (id + 1) * words / threads;
+                for (std::size_t word = begin; word < end; ++word) {
+                    std::uint64_t open = ~visited[word].load(std::memory_order_relaxed);
+                    while (open) {
+                        auto index = static_cast<std::uint32_t>(
+                            word * 64 + static_cast<std::size_t>(std::countr_zero(open)));
+                        open &= open - 1;
+                        Cell cell{index / width, index % width};
+                        for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
+                            Direction dir = static_cast<Direction>(d);
+                            if (!cell.hasDir(dir, width, height)) continue;
+                            if (in_last_level(index_of(cell.toward(dir)))) {
+                                claim(index);
+                                level[index] = depth;
+                                out.push_back(index);
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    run_team(threads, worker);
+}
+
+template <GraphCell G>
+std::vector<std::uint32_t> GenericMaze<G>::hopMap(Cell source, std::size_t threads) const {
+    if (source.row >= height || source.col >= width) {
+        throw std::out_of_range("Cell (" + std::to_string(source.row) + ", "
+            + std::to_string(source.col) + ") out of bounds for maze of size "
+            + std::to_string(width) + "x" + std::to_string(height));
+    }
+    SearchOptions options;
+    options.threads = threads;
+    SearchControl control(options, std::nullopt);
+    std::vector<std::uint32_t> level;
+    parallel_bfs(source, std::nullopt, control, level);
+    return level;
+}
+
+template <GraphCell G>
+Path GenericMaze<G>::parallel_bfs_path(Cell start, Cell dest, SearchControl& control) {
+    MAZE_TRACE_SCOPE("search", "Parallel BFS");
+    std::vector<std::uint32_t> level;
+    parallel_bfs(start, dest, control, level);
+
+    Cell current = control.stopReason() ? *control.best() : dest;
+    std::uint32_t remaining = level[current.row * width + current.col];
+    if (remaining == std::numeric_limits<std::uint32_t>::max()) return {};
+
+    // Walk back down the levels; any neighbour one level closer is a valid parent
+    Path result(remaining);
+    while (remaining > 0) {
+        for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
+            Direction dir = static_cast<Direction>(d);
+            if (!current.hasDir(dir, width, height)) continue;
+            Cell parent = current.toward(dir);
+            if (level[parent.row * width + parent.col] == remaining - 1) {
+                result[--remaining] = reverse(dir);
+                current = parent;
+                break;
+            }
+        }
+    }
+    return result;
+}
@@ -10,6 +10,8 @@
 #include <algorithm>
 #include <vector>
 #include <cmath>
+#include <limits>
+#include <utility>
 
 inline float manhattan_distance(const Cell& a, const Cell& b) {
     std::size_t dr = (a.row > b.row) ? (a.row - b.row) : (b.row - a.row);
@@ -24,105 +26,66 @@ inline float euclidean_distance(const Cell& a, const Cell& b) {
 }
 
 template <GraphCell G>
-Path GenericMaze<G>::bfs(Cell start, Cell dest, ExploreCallback on_explore) {
-    DirectionMap dir_map(width, height);
-    std::unordered_set<Cell> visited;
-    std::queue<Cell> queue;
-
-    visited.insert(start);
-    queue.push(start);
-
-    int depth = 0;
-
-    while (!queue.empty()) {
-        ++depth;
-        std::size_t size = queue.size();
-        while (size-- > 0) {
-            Cell cell = queue.front();
-            queue.pop();
-            if (on_explore) {
-                std::vector<Cell> frontier;
-                frontier.reserve(queue.size());
-                auto temp = queue;
-                while (!temp.empty()) {
-                    frontier.push_back(temp.front());
-                    temp.pop();
-                }
-                on_explore(cell, frontier, visited);
-            }
-            if (cell == dest) {
-                Path result(depth - 1);
-                int i = depth - 2;
-                while (i >= 0) {
-                    result[i] = dir_map[cell];
-                    cell.move(reverse(dir_map[cell]));
-                    --i;
-                }
-                return result;
-            }
-
-            for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
-                Direction dir = static_cast<Direction>(d);
-                if (cell.hasDir(dir, width, height)) {
-                    Cell new_cell = cell.toward(dir);
-                    if (at(new_cell).wall || visited.contains(new_cell)) continue;
-                    queue.push(new_cell);
-                    visited.insert(new_cell);
-                    dir_map[new_cell] = dir;
-                }
-            }
-        }
+float GenericMaze<G>::estimate(Heuristic heuristic, const Cell& from, const Cell& to) const {
+    switch (heuristic) {
+        case Heuristic::Manhattan: return manhattan_distance(from, to);
+        case Heuristic::Euclidean: return euclidean_distance(from, to);
+        case Heuristic::Landmarks:
+            return landmarks_->lowerBound(from, to,
+                cell_at(from).weight, cell_at(to).weight);
     }
-    return {};
+    return 0.0f;
+}
+
+template <GraphCell G>
+Path GenericMaze<G>::bfs(Cell start, Cell dest, SearchControl& control) {
+    MAZE_TRACE_SCOPE("search", "BFS");
+    DenseSearchState state(width, height);
+    return grid_bfs(std::as_const(*this), start, dest, control, state);
 }
 
 template <GraphCell G>
-Path GenericMaze<G>::dfs(Cell start, Cell dest, ExploreCallback on_explore) {
+Path GenericMaze<G>::dfs(Cell start, Cell dest, SearchControl& control) {
+    MAZE_TRACE_SCOPE("search", "DFS");
     if (start == dest) return {};
 
-    DirectionMap dir_map(width, height);
-    std::unordered_set<Cell> visited;
-    std::stack<Cell> stack;
+    const SearchOptions& options = control.options();
+    DenseSearchState state(width, height);
+    std::unordered_set<Cell> visited;  // Only kept for on_explore
+    std::stack<CellId> stack;
 
-    visited.insert(start);
-    stack.push(start);
+    state.dir(state.id(start)) = Direction::COUNT;
+    stack.push(state.id(start));
+    if (options.on_explore) visited.insert(start);
 
     while (!stack.empty()) {
-        Cell cell = stack.top();
+        Cell cell = state.cell(stack.top());
         stack.pop();
-        if (on_explore) {
+        if (!control.expand(cell)) return trace_path(state, start, *control.best());
+        if (options.on_explore) {
             std::vector<Cell> frontier;
             frontier.reserve(stack.size());
             auto temp = stack;
             while (!temp.empty()) {
-                frontier.push_back(temp.top());
+                frontier.push_back(state.cell(temp.top()));
                 temp.pop();
             }
-            on_explore(cell, frontier, visited);
+            options.on_explore(cell, frontier, visited);
         }
 
         for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
             Direction dir = static_cast<Direction>(d);
             if (cell.hasDir(dir, width, height)) {
                 Cell neighbor = cell.toward(dir);
-                if (at(neighbor).wall || visited.contains(neighbor)) continue;
-
-                visited.insert(neighbor);
-                dir_map[neighbor] = dir;
-
-                if (neighbor == dest) {
-                    // Reconstruct path
-                    Path result;
-                    Cell current = dest;
-                    while (!(current == start)) {
-                        result.push_back(dir_map[current]);
-                        current.move(reverse(dir_map[current]));
-                    }
-                    std::reverse(result.begin(), result.end());
-                    return result;
-                }
+                CellId neighbor_id = state.id(neighbor);
+                if (at(neighbor).wall || state.reached(neighbor_id)) continue;
+
+                state.dir(neighbor_id) = dir;
+                if (options.on_explore) visited.insert(neighbor);
 
-                stack.push(neighbor);
+                if (neighbor == dest) return trace_path(state, start, dest);
+
+                stack.push(neighbor_id);
             }
         }
     }
@@ -130,15 +93,16 @@ Path GenericMaze<G>::dfs(Cell start, Cell dest, ExploreCallback on_explore) {
 }
 
 template <GraphCell G>
-Path GenericMaze<G>::dijkstra(Cell start, Cell dest, ExploreCallback on_explore) {
+Path GenericMaze<G>::dijkstra(Cell start, Cell dest, SearchControl& control) {
+    MAZE_TRACE_SCOPE("search", "Dijkstra");
     if (start == dest) return {};
 
-    DirectionMap dir_map(width, height);
-    std::unordered_map<Cell, float> dist;
-    std::unordered_set<Cell> visited;
+    const SearchOptions& options = control.options();
+    DenseSearchState state(width, height);
+    std::unordered_set<Cell> visited;  // Only kept for on_explore
 
     // Min-heap: (distance, cell)
-    using PQEntry = std::pair<float, Cell>;
+    using PQEntry = std::pair<float, CellId>;
     struct MinCost {
         bool operator()(const PQEntry& a, const PQEntry& b) const {
             return a.first > b.first;
@@ -146,39 +110,33 @@ Path GenericMaze<G>::dijkstra(Cell start, Cell dest, ExploreCallback on_explore)
     };
     std::priority_queue<PQEntry, std::vector<PQEntry>, MinCost> pq;
 
-    dist[start] = 0.0f;
-    pq.emplace(0.0f, start);
+    state.trackCosts();
+    state.cost(state.id(start)) = 0.0f;
+    state.dir(state.id(start)) = Direction::COUNT;
+    pq.emplace(0.0f, state.id(start));
 
     while (!pq.empty()) {
-        auto [d, cell] = pq.top();
+        auto [d, id] = pq.top();
         pq.pop();
 
         // Skip stale entries
-        if (dist.contains(cell) && d > dist[cell]) continue;
-        visited.insert(cell);
+        if (d > state.cost(id)) continue;
+        Cell cell = state.cell(id);
+        if (options.on_explore) visited.insert(cell);
+        if (!control.expand(cell)) return trace_path(state, start, *control.best());
 
-        if (on_explore) {
+        if (options.on_explore) {
             std::vector<Cell> frontier;
             frontier.reserve(pq.size());
             auto temp = pq;
             while (!temp.empty()) {
-                frontier.push_back(temp.top().second);
+                frontier.push_back(state.cell(temp.top().second));
                 temp.pop();
             }
-            on_explore(cell, frontier, visited);
+            options.on_explore(cell, frontier, visited);
         }
 
-        if (cell == dest) {
-            // Reconstruct path
-            Path result;
-            Cell current = dest;
-            while (!(current == start)) {
-                result.push_back(dir_map[current]);
-                current.move(reverse(dir_map[current]));
-            }
-            std::reverse(result.begin(), result.end());
-            return result;
-        }
+        if (cell == dest) return trace_path(state, start, dest);
 
         for (std::uint8_t di = 0; di < Direction::COUNT; ++di) {
             Direction dir = static_cast<Direction>(di);
@@ -187,11 +145,12 @@ Path GenericMaze<G>::dijkstra(Cell start, Cell dest, ExploreCallback on_explore)
                 const G& neighbor_data = at(neighbor);
                 if (neighbor_data.wall) continue;
 
-                float new_dist = dist[cell] + neighbor_data.weight;
-                if (!dist.contains(neighbor) || new_dist < dist[neighbor]) {
-                    dist[neighbor] = new_dist;
-                    dir_map[neighbor] = dir;
-                    pq.emplace(new_dist, neighbor);
+                CellId neighbor_id = state.id(neighbor);
+                float new_dist = d + neighbor_data.weight;
+                if (new_dist < state.cost(neighbor_id)) {
+                    state.cost(neighbor_id) = new_dist;
+                    state.dir(neighbor_id) = dir;
+                    pq.emplace(new_dist, neighbor_id);
                 }
             }
         }
@@ -200,14 +159,24 @@ Path GenericMaze<G>::dijkstra(Cell start, Cell dest, ExploreCallback on_explore)
 }
 
 template <GraphCell G>
-Path GenericMaze<G>::a_star(Cell start, Cell dest, ExploreCallback on_explore) {
+Path GenericMaze<G>::a_star(Cell start, Cell dest, SearchControl& control) {
+    MAZE_TRACE_SCOPE("search", "A*");
+    DenseSearchState state(width, height);
+    const Heuristic heuristic = control.options().heuristic;
+    return grid_a_star(std::as_const(*this), start, dest, control, state,
+        [&](const Cell& from, const Cell& to) { return estimate(heuristic, from, to); });
+}
+
+template <GraphCell G>
+Path GenericMaze<G>::greedy_best_first(Cell start, Cell dest, SearchControl& control) {
+    MAZE_TRACE_SCOPE("search", "Greedy Best-First");
     if (start == dest) return {};
 
-    DirectionMap dir_map(width, height);
-    std::unordered_map<Cell, float> g_score;
-    std::unordered_set<Cell> visited;
+    const SearchOptions& options = control.options();
+    DenseSearchState state(width, height);
+    std::unordered_set<Cell> visited;  // Only kept for on_explore
 
-    using PQEntry = std::pair<float, Cell>;
+    using PQEntry = std::pair<float, CellId>;
     struct MinCost {
         bool operator()(const PQEntry& a, const PQEntry& b) const {
             return a.first > b.first;
@@ -215,69 +184,49 @@ Path GenericMaze<G>::a_star(Cell start, Cell dest, ExploreCallback on_explore) {
     };
     std::priority_queue<PQEntry, std::vector<PQEntry>, MinCost> pq;
 
-    g_score[start] = 0.0f;
-    pq.emplace(manhattan_distance(start, dest), start);
+    state.dir(state.id(start)) = Direction::COUNT;
+    if (options.on_explore) visited.insert(start);
+    pq.emplace(estimate(options.heuristic, start, dest), state.id(start));
 
     while (!pq.empty()) {
-        auto [f_score, cell] = pq.top();
+        Cell cell = state.cell(pq.top().second);
         pq.pop();
+        if (!control.expand(cell)) return trace_path(state, start, *control.best());
 
-        if (cell == dest) {
-            Path result;
-            Cell current = dest;
-            while (!(current == start)) {
-                result.push_back(dir_map[current]);
-                current.move(reverse(dir_map[current]));
-            }
-            std::reverse(result.begin(), result.end());
-            return result;
-        }
-
-        if (g_score.contains(cell)) {
-            float expected_f = g_score[cell] + manhattan_distance(cell, dest);
-            if (f_score > expected_f) continue;
-        }
-        visited.insert(cell);
-
-        if (on_explore) {
+        if (options.on_explore) {
             std::vector<Cell> frontier;
             frontier.reserve(pq.size());
             auto temp = pq;
             while (!temp.empty()) {
-                frontier.push_back(temp.top().second);
+                frontier.push_back(state.cell(temp.top().second));
                 temp.pop();
             }
-            on_explore(cell, frontier, visited);
+            options.on_explore(cell, frontier, visited);
         }
 
+        if (cell == dest) return trace_path(state, start, dest);
+
         for (std::uint8_t di = 0; di < Direction::COUNT; ++di) {
             Direction dir = static_cast<Direction>(di);
             if (!cell.hasDir(dir, width, height)) continue;
 
             Cell neighbor = cell.toward(dir);
-            const G& neighbor_data = at(neighbor);
-            if (neighbor_data.wall) continue;
+            CellId neighbor_id = state.id(neighbor);
+            if (at(neighbor).wall || state.reached(neighbor_id)) continue;
 
-            float tentative_g = g_score[cell] + neighbor_data.weight;
-            if (!g_score.contains(neighbor) || tentative_g < g_score[neighbor]) {
-                g_score[neighbor] = tentative_g;
-                dir_map[neighbor] = dir;
-                float f = tentative_g + manhattan_distance(neighbor, dest);
-                pq.emplace(f, neighbor);
-            }
+            state.dir(neighbor_id) = dir;
+            if (options.on_explore) visited.insert(neighbor);
+            pq.emplace(estimate(options.heuristic, neighbor, dest), neighbor_id);
         }
     }
     return {};
 }
 
 template <GraphCell G>
-Path GenericMaze<G>::greedy_best_first(Cell start, Cell dest, ExploreCallback on_explore) {
-    if (start == dest) return {};
-
-    DirectionMap dir_map(width, height);
-    std::unordered_set<Cell> visited;
+std::vector<float> GenericMaze<G>::distances_from(Cell source) const {
+    std::vector<float> dist(width * height, std::numeric_limits<float>::infinity());
 
-    using PQEntry = std::pair<float, Cell>;
+    using PQEntry = std::pair<float, CellId>;
     struct MinCost {
         bool operator()(const PQEntry& a, const PQEntry& b) const {
             return a.first > b.first;
@@ -285,46 +234,32 @@ Path GenericMaze<G>::greedy_best_first(Cell start, Cell dest, ExploreCallback on
     };
     std::priority_queue<PQEntry, std::vector<PQEntry>, MinCost> pq;
 
-    visited.insert(start);
-    pq.emplace(manhattan_distance(start, dest), start);
+    const CellId source_id = CellId::from(source, width);
+    dist[source_id.index] = 0.0f;
+    pq.emplace(0.0f, source_id);
 
     while (!pq.empty()) {
-        auto [priority, cell] = pq.top();
+        auto [d, id] = pq.top();
         pq.pop();
-
-        if (on_explore) {
-            std::vector<Cell> frontier;
-            frontier.reserve(pq.size());
-            auto temp = pq;
-            while (!temp.empty()) {
-                frontier.push_back(temp.top().second);
-                temp.pop();
-            }
-            on_explore(cell, frontier, visited);
-        }
-
-        if (cell == dest) {
-            Path result;
-            Cell current = dest;
-            while (!(current == start)) {
-                result.push_back(dir_map[current]);
-                current.move(reverse(dir_map[current]));
-            }
-            std::reverse(result.begin(), result.end());
-            return result;
-        }
+        if (d > dist[id.index]) continue;
+        Cell cell = id.toCell(width);
 
         for (std::uint8_t di = 0; di < Direction::COUNT; ++di) {
             Direction dir = static_cast<Direction>(di);
             if (!cell.hasDir(dir, width, height)) continue;
 
             Cell neighbor = cell.toward(dir);
-            if (at(neighbor).wall || visited.contains(neighbor)) continue;
+            const G& neighbor_data = cell_at(neighbor);
+            if (neighbor_data.wall) continue;
 
-            visited.insert(neighbor);
-            dir_map[neighbor] = dir;
-            pq.emplace(manhattan_distance(neighbor, dest), neighbor);
+            CellId neighbor_id = CellId::from(neighbor, width);
+            float new_dist = d + neighbor_data.weight;
+            float& best = dist[neighbor_id.index];
+            if (new_dist < best) {
+                best = new_dist;
+                pq.emplace(new_dist, neighbor_id);
+            }
         }
     }
-    return {};
+    return dist;
 }
@@ -0,0 +1,61 @@
+// race.tpp - Template implementations for running engines side by side
+// Included at the end of maze.hpp
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+template <GraphCell G>
+void GenericMaze<G>::race(Cell start, Cell dest, std::vector<RaceEntry>& entries,
+    const SearchOptions& options) {
+    // Resolve the sentinel here so every lane's cost is measured to the same cell
+    if (start == Cell{0, 0} && dest == Cell{0, 0}) {
+        dest = {height - 1, width - 1};
+    }
+    // A bad option would fail every affected lane, so report it once, up front
+    for (const RaceEntry& entry : entries) check_options(entry.algorithm, options);
+
+    auto run_lane = [&, start, dest](RaceEntry& entry) {
+        SearchOptions lane = options;
+        lane.on_explore = nullptr;
+        lane.trace = nullptr;  // One trace cannot take appends from several lanes
+        lane.expansions = &entry.expansions;
+
+        auto began = std::chrono::steady_clock::now();
+        // One failing engine must not take the other lanes, or the process, down
+        try {
+            entry.path = findPath(entry.algorithm, start, dest, lane);
+        } catch (const std::exception& error) {
+            entry.error = error.what();
+        } catch (...) {
+            entry.error = "unknown error";
+        }
+        entry.elapsed = std::chrono::steady_clock::now() - began;
+
+        if (entry.error.empty() && (!entry.path.empty() || start == dest)) {
+            entry.cost = 0.0f;
+            Cell current = start;
+            for (Direction dir : entry.path) {
+                current.move(dir);
+                entry.cost += cell_at(current).weight;
+            }
+        }
+        entry.finished.store(true, std::memory_order_release);
+    };
+
+    std::vector<std::jthread> lanes;
+    lanes.reserve(entries.size());
+    for (RaceEntry& entry : entries) lanes.emplace_back(run_lane, std::ref(entry));
+}
+
+template <GraphCell G>
+std::vector<RaceEntry> GenericMaze<G>::race(Cell start, Cell dest, const SearchOptions& options) {
+    std::vector<RaceEntry> entries(kAllAlgorithms.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) entries[i].algorithm = kAllAlgorithms[i];
+    race(start, dest, entries, options);
+    return entries;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/// @brief Walker/Vose alias table for O(1) weighted sampling from a fixed pool.
+///
+/// Built once in O(n); each sample then costs one random word, a column
+/// lookup and a biased coin. All-zero weights fall back to a uniform pick.
+class AliasTable {
+public:
+    /// @brief Build the table; throws std::invalid_argument on an empty pool
+    /// or a negative weight.
+    explicit AliasTable(const std::vector<float>& weights)
+        : probability_(weights.size(), 1.0f), alias_(weights.size()) {
+        if (weights.empty()) throw std::invalid_argument("Cannot sample from an empty pool");
+
+        double total = 0.0;
+        for (float weight : weights) {
+            if (weight < 0.0f) throw std::invalid_argument("Sampling weights must be non-negative");
+            total += weight;
+        }
+        const std::size_t n = weights.size();
+        for (std::size_t i = 0; i < n; ++i) alias_[i] = static_cast<std::uint32_t>(i);
+        if (total <= 0.0) return;
+
+        std::vector<double> scaled(n);
+        std::vector<std::uint32_t> small, large;
+        for (std::size_t i = 0; i < n; ++i) {
+            scaled[i] = weights[i] * static_cast<double>(n) / total;
+            (scaled[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+        }
+        while (!small.empty() && !large.empty()) {
+            std::uint32_t s = small.back();
+            std::uint32_t l = large.back();
+            small.pop_back();
+            probability_[s] = static_cast<float>(scaled[s]);
+            alias_[s] = l;
+            scaled[l] -= 1.0 - scaled[s];
+            if (scaled[l] < 1.0) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+        // Leftovers are 1 up to rounding error and keep their own column
+    }
+
+    /// @brief Number of entries in the pool.
+    std::size_t size() const { return alias_.size(); }
+
+    /// @brief Pick an index using one 64-bit random word.
+    std::size_t sample(std::uint64_t bits) const {
+        std::size_t column = static_cast<std::size_t>(((bits >> 32) * alias_.size()) >> 32);
+        float coin = static_cast<float>(bits & 0xFFFFFF) * 0x1.0p-24f;
+        return coin < probability_[column] ? column : alias_[column];
+    }
+
+private:
+    std::vector<float> probability_;
+    std::vector<std::uint32_t> alias_;
+};
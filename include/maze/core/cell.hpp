@@ -28,8 +28,3 @@ namespace std {
         }
     };
 }
-
-/// @brief DirectionMap::operator[] implementation (requires complete Cell type).
-inline Direction& DirectionMap::operator[](Cell cell) {
-    return map[cell.row][cell.col];
-}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "cell.hpp"
+#include "direction.hpp"
+
+/// @brief Row-major linear cell index.
+///
+/// Converting to and from a Cell needs the grid width. A CellId is a quarter
+/// the size of a Cell, so queue entries and frontiers built from it keep far
+/// more of a large search in cache.
+template <typename Index>
+struct BasicCellId {
+    Index index = 0;
+
+    /// @brief Id of a cell in a grid `width` columns wide.
+    static BasicCellId from(Cell cell, std::size_t width) {
+        return {static_cast<Index>(cell.row * width + cell.col)};
+    }
+    /// @brief Coordinates of this id in a grid `width` columns wide.
+    Cell toCell(std::size_t width) const {
+        return {static_cast<std::size_t>(index / width), static_cast<std::size_t>(index % width)};
+    }
+
+    bool operator==(const BasicCellId&) const = default;
+};
+
+/// @brief 32-bit id for stored grids of fewer than 2^32 cells.
+using CellId = BasicCellId<std::uint32_t>;
+/// @brief 64-bit id for procedural sources too large for CellId.
+using WideCellId = BasicCellId<std::uint64_t>;
+
+namespace std {
+    /// @brief Hash for using cell ids in unordered containers.
+    template <typename Index> struct hash<BasicCellId<Index>> {
+        size_t operator()(const BasicCellId<Index>& id) const noexcept {
+            return std::hash<Index>{}(id.index);
+        }
+    };
+}
+
+/// @brief Dense predecessor directions, one byte per cell.
+struct DirectionMap {
+    /// @brief Stored for cells no search has reached yet.
+    static constexpr Direction kUnset = static_cast<Direction>(0xFF);
+
+    /// @brief Allocate a width x height map with every cell unset.
+    DirectionMap(std::size_t width, std::size_t height)
+        : dirs_(width * height, kUnset) {}
+
+    /// @brief Access the stored direction for a cell.
+    Direction& operator[](CellId id) { return dirs_[id.index]; }
+    /// @brief True once a direction (or Direction::COUNT for a root) was stored.
+    bool contains(CellId id) const { return dirs_[id.index] != kUnset; }
+
+private:
+    std::vector<Direction> dirs_;
+};
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+#include "cell.hpp"
+#include "graph_cell.hpp"
+
+/// @brief Read-only grid of cells that the shared search engines can walk.
+///
+/// GenericMaze satisfies this with its stored grid; ProceduralMaze computes
+/// each cell on demand. at_unchecked may return a reference or a value.
+template <typename S>
+concept CellSource = requires(const S& source, Cell cell) {
+    { source.getWidth() } -> std::convertible_to<std::size_t>;
+    { source.getHeight() } -> std::convertible_to<std::size_t>;
+    requires GraphCell<std::remove_cvref_t<decltype(source.at_unchecked(cell))>>;
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "cell.hpp"
+
+/// @brief Order in which a search expanded cells, recorded at full speed.
+///
+/// Each step stores the change in row-major index from the previous step as
+/// a zigzag varint. Searches mostly expand next to the last cell, so a step
+/// usually costs one or two bytes. A checkpoint every kCheckpointStride
+/// steps lets at() start decoding close to any step, so replay can jump
+/// anywhere.
+class ExplorationTrace {
+public:
+    static constexpr std::size_t kCheckpointStride = 256;
+
+    /// @brief Empty trace for a grid `width` columns wide.
+    explicit ExplorationTrace(std::size_t width = 0) : width_(width) {}
+
+    /// @brief Drop every step and switch to a grid `width` columns wide.
+    void clear(std::size_t width) {
+        width_ = width;
+        bytes_.clear();
+        checkpoints_.clear();
+        last_ = 0;
+        steps_ = 0;
+    }
+
+    /// @brief Append the next expanded cell.
+    void record(Cell cell) {
+        const std::uint64_t index = cell.row * width_ + cell.col;
+        if (steps_ % kCheckpointStride == 0) checkpoints_.push_back({bytes_.size(), last_});
+        const auto delta = static_cast<std::int64_t>(index - last_);
+        // Zigzag so small steps in either direction stay small
+        std::uint64_t value = (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63);
+        while (value >= 0x80) {
+            bytes_.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes_.push_back(static_cast<std::uint8_t>(value));
+        last_ = index;
+        ++steps_;
+    }
+
+    /// @brief Number of recorded steps.
+    std::size_t size() const { return steps_; }
+    bool empty() const { return steps_ == 0; }
+    std::size_t width() const { return width_; }
+    /// @brief Encoded size, checkpoints included.
+    std::size_t bytes() const {
+        return bytes_.size() + checkpoints_.size() * sizeof(Checkpoint);
+    }
+
+    /// @brief Cell expanded at `step` (0-based); decodes at most one stride.
+    Cell at(std::size_t step) const {
+        const Checkpoint& checkpoint = checkpoints_[step / kCheckpointStride];
+        std::size_t offset = checkpoint.offset;
+        std::uint64_t index = checkpoint.previous;
+        for (std::size_t i = step - step % kCheckpointStride; i <= step; ++i) {
+            index = decode(offset, index);
+        }
+        return to_cell(index);
+    }
+
+    /// @brief Call `visit(step, cell)` for every step in order.
+    template <typename Visit>
+    void forEach(Visit&& visit) const {
+        std::size_t offset = 0;
+        std::uint64_t index = 0;
+        for (std::size_t step = 0; step < steps_; ++step) {
+            index = decode(offset, index);
+            visit(step, to_cell(index));
+        }
+    }
+
+private:
+    struct Checkpoint {
+        std::size_t offset;
+        /// @brief Index of the step before the checkpointed one.
+        std::uint64_t previous;
+    };
+
+    std::uint64_t decode(std::size_t& offset, std::uint64_t previous) const {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            const std::uint8_t byte = bytes_[offset++];
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+        }
+        const auto delta = static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        return previous + static_cast<std::uint64_t>(delta);
+    }
+    Cell to_cell(std::uint64_t index) const {
+        return {static_cast<std::size_t>(index / width_), static_cast<std::size_t>(index % width_)};
+    }
+
+    std::size_t width_;
+    std::vector<std::uint8_t> bytes_;
+    std::vector<Checkpoint> checkpoints_;
+    std::uint64_t last_ = 0;
+    std::size_t steps_ = 0;
+};
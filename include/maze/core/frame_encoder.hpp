@@ -0,0 +1,163 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cell.hpp"
+#include "cell_source.hpp"
+
+/// @brief Encodes grids as ANSI 256-color text into one reusable buffer.
+///
+/// A color escape is written only when the color changes, not once per
+/// cell. frame() also remembers what the terminal shows and rewrites only
+/// the cells that differ, moving the cursor to them, so redrawing a maze
+/// after one cell changes costs a few bytes instead of the whole grid. The
+/// returned view points into the buffer and stays valid until the next call.
+class AnsiFrameEncoder {
+public:
+    /// @brief Every cell as plain rows ending in '\n', for streams and logs.
+    /// Each row sets its own colors and ends reset, so rows stand alone.
+    template <CellSource S>
+    std::string_view full(const S& source) {
+        const std::size_t width = source.getWidth(), height = source.getHeight();
+        buffer_.clear();
+        buffer_.reserve(height * (width * kCellColumns + kRowOverhead));
+        for (std::size_t row = 0; row < height; ++row) {
+            for (std::size_t col = 0; col < width; ++col) {
+                const auto& cell = source.at_unchecked(Cell{row, col});
+                put_glyph({cell.glyph, static_cast<std::uint8_t>(cell.color)});
+            }
+            end_colors();
+            buffer_ += '\n';
+        }
+        return buffer_;
+    }
+
+    /// @brief Update the terminal from the last frame to `source`. The first
+    /// frame after construction, reset() or a size change draws every cell.
+    template <CellSource S>
+    std::string_view frame(const S& source) {
+        begin_frame(source.getWidth(), source.getHeight());
+        update_all(source);
+        return finish_frame();
+    }
+
+    /// @brief As frame(), but only the `touched` cells can have changed since
+    /// the last frame, so the rest are not compared.
+    template <CellSource S>
+    std::string_view frame(const S& source, std::span<const Cell> touched) {
+        if (begin_frame(source.getWidth(), source.getHeight())) {
+            update_all(source);
+        } else {
+            for (Cell cell : touched) update(source, cell);
+        }
+        return finish_frame();
+    }
+
+    /// @brief Forget what the terminal shows; the next frame draws every cell.
+    void reset() { screen_.clear(); }
+
+    /// @brief Cells written by the last frame.
+    std::size_t changedCells() const { return changed_; }
+
+private:
+    struct Glyph {
+        char glyph;
+        std::uint8_t color;
+        bool operator==(const Glyph&) const = default;
+    };
+
+    /// @brief Color escape, reset and newline budgeted per row.
+    static constexpr std::size_t kRowOverhead = 24;
+    /// @brief Terminal columns per cell: the glyph and a spacer.
+    static constexpr std::size_t kCellColumns = 2;
+    static constexpr int kDefaultColor = -1;
+
+    /// @brief Start a frame; true if the screen was cleared and every cell must be drawn.
+    bool begin_frame(std::size_t width, std::size_t height) {
+        buffer_.clear();
+        changed_ = 0;
+        fresh_ = width != width_ || height != height_ || screen_.size() != width * height;
+        if (!fresh_) return false;
+
+        width_ = width;
+        height_ = height;
+        buffer_.reserve(height * (width * kCellColumns + kRowOverhead));
+        buffer_ += "\033[2J";
+        screen_.assign(width * height, Glyph{' ', 0});
+        cursor_ = {height, 0};  // Nowhere on screen, so the first cell moves there
+        return true;
+    }
+
+    std::string_view finish_frame() {
+        end_colors();
+        return buffer_;
+    }
+
+    template <CellSource S>
+    void update_all(const S& source) {
+        for (std::size_t row = 0; row < height_; ++row) {
+            for (std::size_t col = 0; col < width_; ++col) update(source, {row, col});
+        }
+    }
+
+    template <CellSource S>
+    void update(const S& source, Cell cell) {
+        const auto& value = source.at_unchecked(cell);
+        const Glyph next{value.glyph, static_cast<std::uint8_t>(value.color)};
+        Glyph& shown = screen_[cell.row * width_ + cell.col];
+        if (shown == next && !fresh_) return;
+        shown = next;
+        ++changed_;
+        if (cursor_ != cell) move_to(cell);
+        put_glyph(next);
+        cursor_ = {cell.row, cell.col + 1};
+    }
+
+    void move_to(Cell cell) {
+        buffer_ += "\033[";
+        append_number(cell.row + 1);
+        buffer_ += ';';
+        append_number(cell.col * kCellColumns + 1);
+        buffer_ += 'H';
+    }
+
+    void put_glyph(Glyph glyph) {
+        if (glyph.color != color_) {
+            buffer_ += "\033[38;5;";
+            append_number(glyph.color);
+            buffer_ += 'm';
+            color_ = glyph.color;
+        }
+        buffer_ += glyph.glyph;
+        buffer_ += ' ';
+    }
+
+    /// @brief Leave the terminal in its default colors.
+    void end_colors() {
+        if (color_ == kDefaultColor) return;
+        buffer_ += "\033[0m";
+        color_ = kDefaultColor;
+    }
+
+    void append_number(std::size_t value) {
+        char digits[20];
+        auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+        (void)ec;
+        buffer_.append(digits, end);
+    }
+
+    std::string buffer_;
+    /// @brief What the terminal shows, row-major, after the last frame.
+    std::vector<Glyph> screen_;
+    std::size_t width_ = 0, height_ = 0;
+    Cell cursor_{0, 0};
+    int color_ = kDefaultColor;
+    std::size_t changed_ = 0;
+    bool fresh_ = false;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief Resolve a requested worker count (0 = hardware concurrency).
+inline std::size_t resolve_threads(std::size_t requested) {
+    if (requested > 0) return requested;
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+/// @brief Run body(i) for every i in [0, count) on up to `threads` workers.
+///
+/// Items are handed out one at a time, so uneven item costs balance out.
+/// The calling thread participates; the call returns once all items finish.
+/// If a body throws, no further items start and the first exception is
+/// rethrown on the calling thread after every worker has joined.
+template <typename Body>
+void parallel_for(std::size_t count, std::size_t threads, Body&& body) {
+    threads = std::min(resolve_threads(threads), count);
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < count; ++i) body(i);
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    auto work = [&] {
+        try {
+            for (std::size_t i = next++; i < count; i = next++) body(i);
+        } catch (...) {
+            next = count;
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+        }
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(threads - 1);
+        for (std::size_t t = 1; t < threads; ++t) workers.emplace_back(work);
+        work();
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+/// @brief Run body(id) on `threads` workers (ids 0..threads-1) and wait for all.
+///
+/// Worker 0 is the calling thread. This suits SPMD-style engines that step
+/// through phases in lockstep with a std::barrier sized to `threads`.
+/// The first exception a body throws is rethrown after the join. A body that
+/// waits on a shared barrier must still arrive (or drop out) before throwing,
+/// or its teammates never get past it.
+template <typename Body>
+void run_team(std::size_t threads, Body&& body) {
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    auto member = [&](std::size_t id) {
+        try {
+            body(id);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+        }
+    };
+
+    {
+        std::vector<std::jthread> team;
+        team.reserve(threads - 1);
+        for (std::size_t id = 1; id < threads; ++id) team.emplace_back(member, id);
+        member(std::size_t{0});
+    }
+    if (error) std::rethrow_exception(error);
+}
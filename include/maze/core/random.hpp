@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+/// @brief SplitMix64 finalizer: a fast, well-distributed 64-bit bit mixer.
+inline std::uint64_t mix64(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/// @brief Counter-based random word, a pure function of (seed, stream, counter).
+///
+/// Each element of a parallel fill draws from its own counter, so the result
+/// does not depend on how the work is split across threads. Streams keep the
+/// separate draws for one element (e.g. wall coin vs. pool sample) independent.
+inline std::uint64_t random_at(std::uint64_t seed, std::uint64_t stream, std::uint64_t counter) {
+    return mix64(mix64(seed + stream * 0x9E3779B97F4A7C15ULL) ^ (counter * 0xD1B54A32D192ED03ULL));
+}
+
+/// @brief Uniform float in [0, 1) from the top 24 bits of a random word.
+inline float unit_float(std::uint64_t bits) {
+    return static_cast<float>(bits >> 40) * 0x1.0p-24f;
+}
+
+/// @brief Sequential generator that walks the counters of one (seed, stream).
+///
+/// Meets UniformRandomBitGenerator, but std distributions and std::shuffle are
+/// implementation-defined, so use bounded() and shuffle() when the output must
+/// match across standard libraries and machines.
+class CounterRng {
+public:
+    using result_type = std::uint64_t;
+
+    explicit CounterRng(std::uint64_t seed, std::uint64_t stream = 0)
+        : seed_(seed), stream_(stream) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type{0}; }
+
+    result_type operator()() { return random_at(seed_, stream_, counter_++); }
+
+    /// @brief Unbiased integer in [0, bound); bound must be non-zero.
+    std::uint64_t bounded(std::uint64_t bound) {
+        // Reject the few low values that would make the modulo uneven
+        const std::uint64_t threshold = (0 - bound) % bound;
+        std::uint64_t value = (*this)();
+        while (value < threshold) value = (*this)();
+        return value % bound;
+    }
+
+    /// @brief Fisher-Yates shuffle driven by bounded().
+    template <typename RandomIt>
+    void shuffle(RandomIt first, RandomIt last) {
+        for (auto n = last - first; n > 1; --n) {
+            auto pick = static_cast<decltype(n)>(bounded(static_cast<std::uint64_t>(n)));
+            std::iter_swap(first + (n - 1), first + pick);
+        }
+    }
+
+private:
+    std::uint64_t seed_;
+    std::uint64_t stream_;
+    std::uint64_t counter_ = 0;
+};
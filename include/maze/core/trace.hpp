@@ -0,0 +1,190 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// @brief Process-wide recorder of timed scopes, exported as Chrome trace JSON.
+///
+/// Disabled by default. A disabled scope costs one relaxed atomic load. When
+/// enabled, each thread appends to its own buffer, so recording threads never
+/// contend with each other; the buffer lock is only shared with export.
+/// Open the output in chrome://tracing or https://ui.perfetto.dev.
+class Tracer {
+public:
+    /// @brief One completed scope; names must outlive the tracer (string literals).
+    struct Event {
+        const char* category;
+        const char* name;
+        std::int64_t start_ns;
+        std::int64_t duration_ns;
+    };
+
+    /// @brief Events kept per thread; later events are counted and dropped.
+    static constexpr std::size_t kMaxEventsPerThread = std::size_t{1} << 20;
+
+    static Tracer& instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    void enable(bool on = true) { enabled_.store(on, std::memory_order_relaxed); }
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /// @brief Nanoseconds since the tracer was created.
+    std::int64_t now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch_).count();
+    }
+
+    /// @brief Append a completed scope to the calling thread's buffer.
+    void record(const char* category, const char* name, std::int64_t start_ns,
+        std::int64_t end_ns) {
+        Buffer& buffer = local();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        if (buffer.events.size() >= kMaxEventsPerThread) {
+            ++buffer.dropped;
+            return;
+        }
+        buffer.events.push_back({category, name, start_ns, end_ns - start_ns});
+    }
+
+    /// @brief Label the calling thread in exported traces.
+    void nameThread(std::string name) {
+        Buffer& buffer = local();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.name = std::move(name);
+    }
+
+    /// @brief Total events recorded and dropped across all threads.
+    std::pair<std::size_t, std::size_t> counts() const {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        std::size_t events = 0, dropped = 0;
+        for (const auto& buffer : buffers_) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            events += buffer->events.size();
+            dropped += buffer->dropped;
+        }
+        return {events, dropped};
+    }
+
+    /// @brief Discard every recorded event; thread names are kept.
+    void clear() {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        for (const auto& buffer : buffers_) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            buffer->events.clear();
+            buffer->dropped = 0;
+        }
+    }
+
+    /// @brief Write all events in the Chrome trace event format.
+    void writeChromeTrace(std::ostream& os) const {
+        auto quoted = [&os](const std::string& text) {
+            os << '"';
+            for (char c : text) {
+                if (c == '"' || c == '\\') os << '\\';
+                if (static_cast<unsigned char>(c) >= 0x20) os << c;
+            }
+            os << '"';
+        };
+        auto micros = [&os](std::int64_t ns) {
+            os << ns / 1000 << '.' << static_cast<char>('0' + ns / 100 % 10)
+               << static_cast<char>('0' + ns / 10 % 10) << static_cast<char>('0' + ns % 10);
+        };
+
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        for (const auto& buffer : buffers_) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            if (!buffer->name.empty()) {
+                os << (first ? "" : ",") << "\n{\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+                   << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+                quoted(buffer->name);
+                os << "}}";
+                first = false;
+            }
+            for (const Event& event : buffer->events) {
+                os << (first ? "" : ",") << "\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+                   << ",\"cat\":";
+                quoted(event.category);
+                os << ",\"name\":";
+                quoted(event.name);
+                os << ",\"ts\":";
+                micros(event.start_ns);
+                os << ",\"dur\":";
+                micros(event.duration_ns);
+                os << '}';
+                first = false;
+            }
+        }
+        os << "\n]}\n";
+    }
+
+private:
+    struct Buffer {
+        std::uint32_t tid = 0;
+        std::string name;
+        std::vector<Event> events;
+        std::size_t dropped = 0;
+        mutable std::mutex mutex;
+    };
+
+    Tracer() : epoch_(std::chrono::steady_clock::now()) {}
+
+    /// @brief The calling thread's buffer, registered on first use. Buffers
+    /// belong to the tracer, so events outlive the threads that recorded them.
+    Buffer& local() {
+        thread_local Buffer* buffer = nullptr;
+        if (!buffer) {
+            std::lock_guard<std::mutex> lock(buffers_mutex_);
+            buffers_.push_back(std::make_unique<Buffer>());
+            buffer = buffers_.back().get();
+            buffer->tid = static_cast<std::uint32_t>(buffers_.size());
+        }
+        return *buffer;
+    }
+
+    std::atomic<bool> enabled_{false};
+    std::chrono::steady_clock::time_point epoch_;
+    std::vector<std::unique_ptr<Buffer>> buffers_;
+    mutable std::mutex buffers_mutex_;
+};
+
+/// @brief Records its own lifetime as one trace event if tracing was on at entry.
+class TraceScope {
+public:
+    TraceScope(const char* category, const char* name)
+        : category_(category), name_(name),
+          start_(Tracer::instance().enabled() ? Tracer::instance().now() : -1) {}
+    ~TraceScope() {
+        if (start_ >= 0) Tracer::instance().record(category_, name_, start_, Tracer::instance().now());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* category_;
+    const char* name_;
+    std::int64_t start_;
+};
+
+#define MAZE_TRACE_CONCAT_INNER(a, b) a##b
+#define MAZE_TRACE_CONCAT(a, b) MAZE_TRACE_CONCAT_INNER(a, b)
+
+/// @brief Trace the rest of the enclosing block. Compiled out by MAZE_NO_TRACING.
+#ifdef MAZE_NO_TRACING
+#define MAZE_TRACE_SCOPE(category, name) ((void)0)
+#else
+#define MAZE_TRACE_SCOPE(category, name) \
+    TraceScope MAZE_TRACE_CONCAT(maze_trace_scope_, __LINE__)(category, name)
+#endif
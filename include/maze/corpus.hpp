@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "maze.hpp"
+
+/// @brief One maze to generate into a corpus.
+struct CorpusJob {
+    std::size_t width = 0;
+    std::size_t height = 0;
+    /// @brief Perfect-maze generator, used when `random_cells` is empty.
+    GenerationAlgorithm algorithm = GenerationAlgorithm::RecursiveBacktracker;
+    CellMetaData wall{true, '#', Color::gray, 1.0f};
+    CellMetaData passage{false, ' ', Color::white, 1.0f};
+    /// @brief Pool for generateRandom, walls included; empty uses `algorithm`.
+    std::vector<CellMetaData> random_cells;
+    float wall_density = 0.3f;
+    /// @brief Passages painted over the result with paintTerrain (empty = none).
+    std::vector<CellMetaData> terrain;
+    std::uint64_t seed = 0;
+};
+
+/// @brief Where one maze sits in a corpus file, and what it is.
+struct CorpusEntry {
+    /// @brief Byte offset and length of the maze's record.
+    std::uint64_t offset = 0;
+    std::uint64_t bytes = 0;
+    std::size_t width = 0;
+    std::size_t height = 0;
+    std::uint64_t seed = 0;
+    /// @brief GenericMaze::fingerprint() of the stored maze.
+    std::uint64_t fingerprint = 0;
+};
+
+/// @brief Generate every job on a worker pool straight into a corpus file.
+///
+/// Each record holds the job's cell palette and one bit-packed palette index
+/// per cell, so a wall/passage maze costs one bit per cell. Record sizes
+/// follow from the jobs alone, so every worker writes its mazes at offsets
+/// fixed up front through its own stream, with no ordering between workers.
+/// Jobs are handed out grouped by size and each worker reuses its grid while
+/// the size repeats. The index goes at the end of the file. The same jobs
+/// give a byte-identical file for any thread count.
+/// @param threads Worker count (0 = hardware concurrency).
+/// @return The index, in job order.
+/// @throws std::invalid_argument if a job has no cells or more than 256 cell kinds.
+/// @throws std::runtime_error if the file cannot be written.
+std::vector<CorpusEntry> buildCorpus(const std::string& path,
+    const std::vector<CorpusJob>& jobs, std::size_t threads = 0);
+
+/// @brief Random access to the mazes in a corpus file.
+///
+/// The index is read once; load() opens its own stream, so any number of
+/// threads can load mazes at once.
+class CorpusReader {
+public:
+    /// @brief Read the index; throws std::runtime_error on a bad file.
+    explicit CorpusReader(std::string path);
+
+    std::size_t size() const { return entries_.size(); }
+    const std::vector<CorpusEntry>& entries() const { return entries_; }
+
+    /// @brief Decode maze `index`; throws std::out_of_range or std::runtime_error.
+    Maze load(std::size_t index) const;
+
+private:
+    std::string path_;
+    std::vector<CorpusEntry> entries_;
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "maze/core/parallel.hpp"
+
+/// @brief Connected-component labels for the passable cells of a grid.
+///
+/// Labels live in a union-find forest over row-major cell indices where every
+/// root is the smallest index of its component. A rebuild labels horizontal
+/// stripes in parallel with a scanline pass, stitches the stripe borders, and
+/// flattens the forest so each query is a single lookup. Opening a cell merges
+/// it in place; closing one can split a region, so it marks the labels stale
+/// and the next refresh() rebuilds them.
+class ComponentIndex {
+public:
+    static constexpr std::uint32_t npos = UINT32_MAX;
+
+    /// @brief Create an empty, stale index for a width x height grid.
+    ComponentIndex(std::size_t width, std::size_t height, std::size_t threads = 0)
+        : width_(width), height_(height), threads_(threads) {}
+
+    /// @brief Worker count used for rebuilds (0 = hardware concurrency).
+    std::size_t threads() const { return threads_; }
+
+    /// @brief Mark the labels out of date.
+    void invalidate() { stale_.store(true, std::memory_order_relaxed); }
+    /// @brief True if the labels must be rebuilt before use.
+    bool stale() const { return stale_.load(std::memory_order_acquire); }
+
+    /// @brief Rebuild the labels if stale; safe to call from concurrent readers.
+    template <typename IsWall>
+    void refresh(IsWall&& is_wall) {
+        if (!stale()) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stale_.load(std::memory_order_relaxed)) return;
+        rebuild(is_wall);
+        stale_.store(false, std::memory_order_release);
+    }
+
+    /// @brief Merge a cell that just became passable into its neighbours' regions.
+    template <typename IsWall>
+    void open(std::size_t index, IsWall&& is_wall) {
+        if (stale()) return;
+        parent_[index] = static_cast<std::uint32_t>(index);
+        const std::size_t row = index / width_;
+        const std::size_t col = index % width_;
+        if (col > 0 && !is_wall(index - 1)) unite(index, index - 1);
+        if (col + 1 < width_ && !is_wall(index + 1)) unite(index, index + 1);
+        if (row > 0 && !is_wall(index - width_)) unite(index, index - width_);
+        if (row + 1 < height_ && !is_wall(index + width_)) unite(index, index + width_);
+    }
+
+    /// @brief Component label of a cell, or npos for walls. Requires fresh labels.
+    std::uint32_t label(std::size_t index) const {
+        std::uint32_t x = parent_[index];
+        if (x == npos) return npos;
+        while (parent_[x] != x) x = parent_[x];
+        return x;
+    }
+
+    /// @brief True if both cells are passable and share a region. Requires fresh labels.
+    bool connected(std::size_t a, std::size_t b) const {
+        std::uint32_t la = label(a);
+        return la != npos && la == label(b);
+    }
+
+private:
+    std::size_t width_, height_, threads_;
+    std::vector<std::uint32_t> parent_;
+    std::atomic<bool> stale_{true};
+    std::mutex mutex_;
+
+    std::uint32_t find(std::uint32_t x) {
+        while (parent_[x] != x) {
+            parent_[x] = parent_[parent_[x]];
+            x = parent_[x];
+        }
+        return x;
+    }
+
+    void unite(std::size_t a, std::size_t b) {
+        std::uint32_t ra = find(static_cast<std::uint32_t>(a));
+        std::uint32_t rb = find(static_cast<std::uint32_t>(b));
+        if (ra == rb) return;
+        if (ra < rb) {
+            parent_[rb] = ra;
+        } else {
+            parent_[ra] = rb;
+        }
+    }
+
+    template <typename IsWall>
+    void rebuild(IsWall& is_wall) {
+        parent_.assign(width_ * height_, npos);
+
+        // Stripes touch disjoint index ranges, and roots are minimal indices,
+        // so unions inside a stripe never reach another stripe's cells
+        constexpr std::size_t kMinStripeRows = 64;
+        const std::size_t stripes = std::max<std::size_t>(1,
+            std::min(resolve_threads(threads_), height_ / kMinStripeRows));
+        auto stripe_begin = [&](std::size_t s) { return s * height_ / stripes; };
+
+        parallel_for(stripes, stripes, [&](std::size_t s) {
+            for (std::size_t row = stripe_begin(s); row < stripe_begin(s + 1); ++row) {
+                for (std::size_t col = 0; col < width_; ++col) {
+                    std::size_t index = row * width_ + col;
+                    if (is_wall(index)) continue;
+                    parent_[index] = static_cast<std::uint32_t>(index);
+                    if (col > 0 && parent_[index - 1] != npos) unite(index, index - 1);
+                    if (row > stripe_begin(s) && parent_[index - width_] != npos) {
+                        unite(index, index - width_);
+                    }
+                }
+            }
+        });
+
+        for (std::size_t s = 1; s < stripes; ++s) {
+            std::size_t row = stripe_begin(s);
+            for (std::size_t col = 0; col < width_; ++col) {
+                std::size_t index = row * width_ + col;
+                if (parent_[index] != npos && parent_[index - width_] != npos) {
+                    unite(index, index - width_);
+                }
+            }
+        }
+
+        std::vector<std::uint32_t> flat(parent_.size(), npos);
+        parallel_for(stripes, stripes, [&](std::size_t s) {
+            for (std::size_t index = stripe_begin(s) * width_;
+                 index < stripe_begin(s + 1) * width_; ++index) {
+                flat[index] = label(index);
+            }
+        });
+        parent_.swap(flat);
+    }
+};
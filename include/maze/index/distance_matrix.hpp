@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "maze/core/cell.hpp"
+#include "maze/core/direction.hpp"
+#include "maze/core/graph_cell.hpp"
+
+template <GraphCell G>
+class GenericMaze;
+
+/// @brief Pairwise traversal costs between a set of points of interest.
+///
+/// Costs are charged on the cell being entered, like every weighted search,
+/// so cost(i, j) and cost(j, i) differ by the two points' weights. Walls and
+/// cells in other regions are unreachable (infinity); a wall point is
+/// unreachable even from itself. When built with paths,
+/// the matrix keeps each row's search tree (one byte per cell per point) and
+/// rebuilds any path on request.
+class DistanceMatrix {
+public:
+    /// @brief Number of points; the matrix is size() x size().
+    std::size_t size() const { return points_.size(); }
+    /// @brief The points, in the order rows and columns use.
+    const std::vector<Cell>& points() const { return points_; }
+    /// @brief Row-major costs; row i holds the costs from points()[i].
+    const std::vector<float>& costs() const { return costs_; }
+
+    /// @brief Cost from points()[from] to points()[to]; infinity if unreachable.
+    float cost(std::size_t from, std::size_t to) const {
+        check_index(from);
+        check_index(to);
+        return costs_[from * points_.size() + to];
+    }
+
+    /// @brief True if the matrix was built with paths.
+    bool hasPaths() const { return !parents_.empty(); }
+
+    /// @brief Cheapest path from points()[from] to points()[to], empty if it is
+    /// unreachable or the points coincide. Throws std::logic_error if the
+    /// matrix was built without paths.
+    std::vector<Direction> path(std::size_t from, std::size_t to) const {
+        check_index(from);
+        check_index(to);
+        if (!hasPaths()) {
+            throw std::logic_error("Distance matrix was built without paths");
+        }
+        if (!std::isfinite(cost(from, to))) return {};
+
+        const Direction* tree = parents_.data() + from * cells_;
+        std::vector<Direction> steps;
+        for (Cell cell = points_[to]; cell != points_[from];) {
+            const Direction dir = tree[cell.row * width_ + cell.col];
+            steps.push_back(dir);
+            cell = cell.toward(reverse(dir));
+        }
+        std::reverse(steps.begin(), steps.end());
+        return steps;
+    }
+
+private:
+    template <GraphCell G>
+    friend class GenericMaze;
+
+    void check_index(std::size_t index) const {
+        if (index >= points_.size()) {
+            throw std::out_of_range("Point " + std::to_string(index)
+                + " out of range for a matrix of " + std::to_string(points_.size()));
+        }
+    }
+
+    std::size_t width_ = 0;
+    std::size_t cells_ = 0;
+    std::vector<Cell> points_;
+    std::vector<float> costs_;
+    /// @brief Direction each cell was entered by, one width * height block per
+    /// row's search; empty when built without paths.
+    std::vector<Direction> parents_;
+};
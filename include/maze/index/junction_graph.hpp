@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "maze/maze.hpp"
+
+/// @brief Corridor-contracted view of a maze for fast repeated queries.
+///
+/// Every passable cell with exactly two passable neighbours is folded into a
+/// weighted edge between the junctions and dead ends at its ends. Queries
+/// splice the start and destination into this graph and run Dijkstra over
+/// junctions only, then expand the stored direction runs back into a Path.
+/// The graph is a snapshot: rebuild it after editing the maze.
+template <GraphCell G>
+class JunctionGraph {
+public:
+    /// @brief Contract all corridors of the given maze.
+    explicit JunctionGraph(const GenericMaze<G>& maze);
+
+    /// @brief Compute a minimum-cost path using the contracted graph.
+    /// @param expansions If non-null, receives the number of graph nodes expanded.
+    Path findPath(Cell start, Cell dest, std::size_t* expansions = nullptr) const;
+
+    /// @brief Number of junction and dead-end nodes.
+    std::size_t nodeCount() const { return nodes_.size(); }
+    /// @brief Number of contracted corridor edges.
+    std::size_t edgeCount() const { return edges_.size(); }
+
+private:
+    static constexpr std::uint32_t npos = UINT32_MAX;
+
+    /// @brief Straight segment of a corridor.
+    struct Run {
+        Direction dir;
+        std::uint32_t length;
+    };
+
+    struct Node {
+        Cell cell;
+        /// @brief Edge leaving through each direction, or npos.
+        std::array<std::uint32_t, Direction::COUNT> exits;
+    };
+
+    struct Edge {
+        std::uint32_t from, to;
+        std::vector<Run> runs;
+        /// @brief Cost of walking from -> to (weights of entered cells).
+        float forward_cost;
+        /// @brief Cost of walking to -> from.
+        float backward_cost;
+    };
+
+    /// @brief Result of walking a corridor from a cell to the nearest node.
+    struct Walk {
+        std::uint32_t node = npos;
+        Path steps;
+        float cost_out = 0.0f;
+        float cost_in = 0.0f;
+        bool hit_target = false;
+    };
+
+    const GenericMaze<G>& maze_;
+    std::vector<Node> nodes_;
+    std::vector<Edge> edges_;
+    std::unordered_map<std::size_t, std::uint32_t> node_at_;
+
+    std::size_t index_of(Cell cell) const { return cell.row * maze_.getWidth() + cell.col; }
+    bool passable(Cell cell) const { return !maze_.at_unchecked(cell).wall; }
+    std::uint8_t degree(Cell cell) const;
+    std::uint32_t node_id(Cell cell) const;
+    std::uint32_t add_node(Cell cell);
+    void trace_edge(std::uint32_t node, Direction exit, std::vector<bool>& covered);
+    Walk walk(Cell origin, Direction first, Cell target) const;
+    void append_edge(Path& path, std::uint32_t edge, bool forward) const;
+};
+
+#include "junction_graph.tpp"
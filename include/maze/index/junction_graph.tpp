@@ -0,0 +1,316 @@
+// junction_graph.tpp - Template implementations for JunctionGraph
+// Included at the end of junction_graph.hpp
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+template <GraphCell G>
+JunctionGraph<G>::JunctionGraph(const GenericMaze<G>& maze) : maze_(maze) {
+    const std::size_t width = maze_.getWidth();
+    const std::size_t height = maze_.getHeight();
+
+    for (std::size_t row = 0; row < height; ++row) {
+        for (std::size_t col = 0; col < width; ++col) {
+            Cell cell{row, col};
+            if (passable(cell) && degree(cell) != 2) add_node(cell);
+        }
+    }
+
+    std::vector<bool> covered(width * height, false);
+    auto trace_all = [&](std::uint32_t node) {
+        for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
+            Direction dir = static_cast<Direction>(d);
+            Cell cell = nodes_[node].cell;
+            if (!cell.hasDir(dir, width, height) || !passable(cell.toward(dir))) continue;
+            if (nodes_[node].exits[dir] == npos) trace_edge(node, dir, covered);
+        }
+    };
+
+    const std::size_t junctions = nodes_.size();
+    for (std::size_t node = 0; node < junctions; ++node) {
+        trace_all(static_cast<std::uint32_t>(node));
+    }
+
+    // Closed loops of corridor cells have no junction; pin one cell as a node
+    for (std::size_t row = 0; row < height; ++row) {
+        for (std::size_t col = 0; col < width; ++col) {
+            Cell cell{row, col};
+            if (!passable(cell) || covered[index_of(cell)]) continue;
+            if (node_id(cell) != npos) continue;
+            trace_all(add_node(cell));
+        }
+    }
+}
+
+template <GraphCell G>
+std::uint8_t JunctionGraph<G>::degree(Cell cell) const {
+    std::uint8_t count = 0;
+    for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
+        Direction dir = static_cast<Direction>(d);
+        if (cell.hasDir(dir, maze_.getWidth(), maze_.getHeight())
+            && passable(cell.toward(dir))) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+template <GraphCell G>
+std::uint32_t JunctionGraph<G>::node_id(Cell cell) const {
+    auto it = node_at_.find(index_of(cell));
+    return it == node_at_.end() ? npos : it->second;
+}
+
+template <GraphCell G>
+std::uint32_t JunctionGraph<G>::add_node(Cell cell) {
+    auto id = static_cast<std::uint32_t>(nodes_.size());
+    Node node{cell, {}};
+    node.exits.fill(npos);
+    nodes_.push_back(node);
+    node_at_.emplace(index_of(cell), id);
+    return id;
+}
+
+template <GraphCell G>
+void JunctionGraph<G>::trace_edge(std::uint32_t node, Direction exit,
+    std::vector<bool>& covered) {
+    const std::size_t width = maze_.getWidth();
+    const std::size_t height = maze_.getHeight();
+    auto id = static_cast<std::uint32_t>(edges_.size());
+
+    Edge edge{node, npos, {}, 0.0f, 0.0f};
+    Cell cell = nodes_[node].cell;
+    Direction dir = exit;
+
+    while (true) {
+        edge.backward_cost += maze_.at_unchecked(cell).weight;
+        cell.move(dir);
+        edge.forward_cost += maze_.at_unchecked(cell).weight;
+        if (!edge.runs.empty() && edge.runs.back().dir == dir) {
+            ++edge.runs.back().length;
+        } else {
+            edge.runs.push_back({dir, 1});
+        }
+
+        std::uint32_t end = node_id(cell);
+        if (end != npos) {
+            edge.to = end;
+            nodes_[node].exits[exit] = id;
+            nodes_[end].exits[reverse(dir)] = id;
+            break;
+        }
+        covered[index_of(cell)] = true;
+
+        // A corridor cell has exactly one exit besides the way we came in
+        Direction back = reverse(dir);
+        for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
+            Direction next = static_cast<Direction>(d);
+            if (next == back || !cell.hasDir(next, width, height)) continue;
+            if (passable(cell.toward(next))) {
+                dir = next;
+                break;
+            }
+        }
+    }
+    edges_.push_back(std::move(edge));
+}
+
+template <GraphCell G>
+typename JunctionGraph<G>::Walk JunctionGraph<G>::walk(Cell origin, Direction first,
+    Cell target) const {
+    const std::size_t width = maze_.getWidth();
+    const std::size_t height = maze_.getHeight();
+
+    Walk result;
+    Cell cell = origin;
+    Direction dir = first;
+
+    while (true) {
+        result.cost_in += maze_.at_unchecked(cell).weight;
+        cell.move(dir);
+        result.cost_out += maze_.at_unchecked(cell).weight;
+        result.steps.push_back(dir);
+
+        result.node = node_id(cell);
+        if (result.node != npos) return result;
+        if (cell == target) {
+            result.hit_target = true;
+            return result;
+        }
+
+        Direction back = reverse(dir);
+        for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
+            Direction next = static_cast<Direction>(d);
+            if (next == back || !cell.hasDir(next, width, height)) continue;
+            if (passable(cell.toward(next))) {
+                dir = next;
+                break;
+            }
+        }
+    }
+}
+
+template <GraphCell G>
+void JunctionGraph<G>::append_edge(Path& path, std::uint32_t edge, bool forward) const {
+    const auto& runs = edges_[edge].runs;
+    if (forward) {
+        for (const Run& run : runs) {
+            path.insert(path.end(), run.length, run.dir);
+        }
+    } else {
+        for (auto it = runs.rbegin(); it != runs.rend(); ++it) {
+            path.insert(path.end(), it->length, reverse(it->dir));
+        }
+    }
+}
+
+template <GraphCell G>
+Path JunctionGraph<G>::findPath(Cell start, Cell dest, std::size_t* expansions) const {
+    if (expansions) *expansions = 0;
+    if (start == dest) return {};
+
+    const std::size_t width = maze_.getWidth();
+    const std::size_t height = maze_.getHeight();
+    if (start.row >= height || start.col >= width) return {};
+    if (dest.row >= height || dest.col >= width) return {};
+    if (!passable(start) || !passable(dest)) return {};
+
+    // Splice the endpoints in: each links to the node(s) at the ends of its corridor
+    struct Link {
+        std::uint32_t node;
+        float cost;
+        Path steps;
+    };
+    std::vector<Link> sources;
+    std::vector<Link> targets;
+    Path direct;
+    float direct_cost = std::numeric_limits<float>::infinity();
+
+    if (std::uint32_t id = node_id(start); id != npos) {
+        sources.push_back({id, 0.0f, {}});
+    } else {
+        for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
+            Direction dir = static_cast<Direction>(d);
+            if (!start.hasDir(dir, width, height) || !passable(start.toward(dir))) continue;
+            Walk w = walk(start, dir, dest);
+            if (w.hit_target) {
+                direct = std::move(w.steps);
+                direct_cost = w.cost_out;
+            } else {
+                sources.push_back({w.node, w.cost_out, std::move(w.steps)});
+            }
+        }
+    }
+
+    if (std::uint32_t id = node_id(dest); id != npos) {
+        targets.push_back({id, 0.0f, {}});
+    } else {
+        for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
+            Direction dir = static_cast<Direction>(d);
+            if (!dest.hasDir(dir, width, height) || !passable(dest.toward(dir))) continue;
+            Walk w = walk(dest, dir, start);
+            if (w.hit_target) continue;  // Already covered by the direct link
+            Path steps;
+            steps.reserve(w.steps.size());
+            for (auto it = w.steps.rbegin(); it != w.steps.rend(); ++it) {
+                steps.push_back(reverse(*it));
+            }
+            targets.push_back({w.node, w.cost_in, std::move(steps)});
+        }
+    }
+
+    // Dijkstra over junctions plus a virtual source and target
+    const auto source = static_cast<std::uint32_t>(nodes_.size());
+    const std::uint32_t target = source + 1;
+
+    enum class Via : std::uint8_t { SourceLink, Edge, TargetLink, Direct };
+    struct Pred {
+        std::uint32_t prev = npos;
+        std::uint32_t index = npos;
+        Via via = Via::Edge;
+        bool forward = true;
+    };
+
+    std::vector<float> dist(nodes_.size() + 2, std::numeric_limits<float>::infinity());
+    std::vector<Pred> pred(nodes_.size() + 2);
+
+    using PQEntry = std::pair<float, std::uint32_t>;
+    struct MinCost {
+        bool operator()(const PQEntry& a, const PQEntry& b) const {
+            return a.first > b.first;
+        }
+    };
+    std::priority_queue<PQEntry, std::vector<PQEntry>, MinCost> pq;
+
+    auto relax = [&](std::uint32_t node, float cost, Pred via) {
+        if (cost < dist[node]) {
+            dist[node] = cost;
+            pred[node] = via;
+            pq.emplace(cost, node);
+        }
+    };
+
+    dist[source] = 0.0f;
+    for (std::uint32_t i = 0; i < sources.size(); ++i) {
+        relax(sources[i].node, sources[i].cost, {source, i, Via::SourceLink, true});
+    }
+    if (!direct.empty()) relax(target, direct_cost, {source, npos, Via::Direct, true});
+
+    std::size_t expanded = 0;
+    while (!pq.empty()) {
+        auto [d, node] = pq.top();
+        pq.pop();
+        if (d > dist[node]) continue;
+        ++expanded;
+        if (node == target) break;
+
+        for (std::uint32_t i = 0; i < targets.size(); ++i) {
+            if (targets[i].node == node) {
+                relax(target, d + targets[i].cost, {node, i, Via::TargetLink, true});
+            }
+        }
+
+        for (std::uint8_t di = 0; di < Direction::COUNT; ++di) {
+            std::uint32_t e = nodes_[node].exits[di];
+            if (e == npos) continue;
+            const Edge& edge = edges_[e];
+            bool forward = edge.from == node && edge.runs.front().dir == di;
+            std::uint32_t next = forward ? edge.to : edge.from;
+            if (next == node) continue;
+            float cost = forward ? edge.forward_cost : edge.backward_cost;
+            relax(next, d + cost, {node, e, Via::Edge, forward});
+        }
+    }
+
+    if (expansions) *expansions = expanded;
+    if (dist[target] == std::numeric_limits<float>::infinity()) return {};
+
+    std::vector<Pred> chain;
+    for (std::uint32_t node = target; node != source; node = pred[node].prev) {
+        chain.push_back(pred[node]);
+    }
+
+    Path result;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        switch (it->via) {
+            case Via::SourceLink:
+                result.insert(result.end(), sources[it->index].steps.begin(),
+                    sources[it->index].steps.end());
+                break;
+            case Via::Edge:
+                append_edge(result, it->index, it->forward);
+                break;
+            case Via::TargetLink:
+                result.insert(result.end(), targets[it->index].steps.begin(),
+                    targets[it->index].steps.end());
+                break;
+            case Via::Direct:
+                result.insert(result.end(), direct.begin(), direct.end());
+                break;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+#include "maze/core/cell.hpp"
+
+/// @brief Distance tables from a few landmark cells, used for ALT lower bounds.
+///
+/// For every landmark L the table stores d(L, v), the cost of walking from L to
+/// each cell v. Costs are charged on the cell being entered, so reversing a path
+/// gives d(v, L) = d(L, v) + w(L) - w(v) and one table per landmark yields both
+/// triangle-inequality bounds. Tables are plain data and can be saved once and
+/// reloaded by any process working on a maze with the same fingerprint.
+struct LandmarkTable {
+    std::size_t width = 0;
+    std::size_t height = 0;
+    /// @brief GenericMaze::fingerprint() of the maze the tables were built from.
+    std::uint64_t fingerprint = 0;
+    std::vector<Cell> landmarks;
+    /// @brief Row-major costs, one width * height block per landmark.
+    std::vector<float> distances;
+
+    /// @brief Admissible estimate of the cost from one cell to another.
+    /// @param from_weight Weight of the cell the estimate starts at.
+    /// @param to_weight Weight of the destination cell.
+    float lowerBound(const Cell& from, const Cell& to,
+        float from_weight, float to_weight) const {
+        const std::size_t cells = width * height;
+        const std::size_t v = from.row * width + from.col;
+        const std::size_t t = to.row * width + to.col;
+        float best = 0.0f;
+        for (std::size_t i = 0; i < landmarks.size(); ++i) {
+            float to_v = distances[i * cells + v];
+            float to_t = distances[i * cells + t];
+            bool reach_v = std::isfinite(to_v);
+            bool reach_t = std::isfinite(to_t);
+            // A landmark that reaches only one of the two cells proves they
+            // lie in different regions
+            if (reach_v != reach_t) return std::numeric_limits<float>::infinity();
+            if (!reach_v) continue;
+            best = std::max({best, to_t - to_v, to_v - to_t + to_weight - from_weight});
+        }
+        return best;
+    }
+
+    /// @brief Write the tables in a portable little-endian binary format.
+    void save(std::ostream& os) const;
+    /// @brief Read tables written by save(); throws std::runtime_error on bad input.
+    static LandmarkTable load(std::istream& is);
+};
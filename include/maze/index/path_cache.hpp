@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "maze/core/direction.hpp"
+#include "maze/core/random.hpp"
+
+/// @brief LRU cache of search results for a maze that is edited between queries.
+///
+/// Cells are row-major indices. Writes to the maze are journaled with the
+/// cell's previous wall flag and weight, and applied on the next reconcile().
+/// An edit that walls a cell off or makes it dearer drops only the entries
+/// whose path crosses that cell: no route got cheaper, so every other entry
+/// keeps both its cost and its optimality. An edit that opens a cell or makes
+/// it cheaper can create a shortcut anywhere and clears the cache. Entries
+/// for unreachable destinations are kept the same way.
+class PathCache {
+public:
+    /// @brief Query identity; algorithm and heuristic are the enum values.
+    struct Key {
+        std::uint64_t start = 0, dest = 0;
+        std::uint8_t algorithm = 0, heuristic = 0;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    /// @brief Counters since the cache was created.
+    struct Stats {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        /// @brief Entries dropped to make room.
+        std::size_t evictions = 0;
+        /// @brief Entries dropped because an edit could have changed them.
+        std::size_t invalidations = 0;
+    };
+
+    /// @param version Maze version the (empty) cache starts in sync with.
+    explicit PathCache(std::size_t capacity, std::uint64_t version = 0)
+        : capacity_(capacity), version_(version) {}
+
+    std::size_t capacity() const { return capacity_; }
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+    Stats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    /// @brief Cached path for a query, marking it most recently used.
+    std::optional<std::vector<Direction>> find(const Key& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            ++stats_.misses;
+            return std::nullopt;
+        }
+        ++stats_.hits;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->path;
+    }
+
+    /// @brief Store a complete result; `cells` are the indices the path visits.
+    void insert(const Key& key, std::vector<Direction> path, std::vector<std::uint64_t> cells) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (capacity_ == 0) return;
+        if (auto it = index_.find(key); it != index_.end()) erase(it->second);
+        while (entries_.size() >= capacity_) {
+            erase(std::prev(entries_.end()));
+            ++stats_.evictions;
+        }
+        entries_.push_front({key, std::move(path), std::move(cells)});
+        index_[key] = entries_.begin();
+        for (std::uint64_t cell : entries_.front().cells) crossing_[cell].push_back(key);
+    }
+
+    /// @brief Record a cell's state before a write that may change it.
+    void noteEdit(std::uint64_t cell, bool wall, float weight) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (journal_.size() >= kMaxJournal) {
+            overflow_ = true;
+            return;
+        }
+        journal_.push_back({cell, wall, weight});
+    }
+
+    /// @brief Record a write of unknown extent, e.g. regenerating the maze.
+    void noteReset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        overflow_ = true;
+    }
+
+    /// @brief Maze version the cache was last reconciled against.
+    std::uint64_t version() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return version_;
+    }
+
+    /// @brief Apply the journaled edits against the maze's current cells.
+    /// @param state Called as state(cell) -> std::pair<bool wall, float weight>.
+    template <typename CellState>
+    void reconcile(std::uint64_t version, CellState&& state) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        version_ = version;
+        bool improved = overflow_;
+        for (const Edit& edit : journal_) {
+            if (improved) break;
+            auto [wall, weight] = state(edit.cell);
+            if (wall == edit.wall && (wall || weight == edit.weight)) continue;
+            if (!wall && (edit.wall || weight < edit.weight)) {
+                improved = true;
+            } else {
+                drop_crossing(edit.cell);
+            }
+        }
+        journal_.clear();
+        overflow_ = false;
+        if (improved) {
+            stats_.invalidations += entries_.size();
+            entries_.clear();
+            index_.clear();
+            crossing_.clear();
+        }
+    }
+
+private:
+    struct Entry {
+        Key key;
+        std::vector<Direction> path;
+        std::vector<std::uint64_t> cells;
+    };
+    struct Edit {
+        std::uint64_t cell;
+        bool wall;
+        float weight;
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return static_cast<std::size_t>(mix64(key.start
+                ^ mix64(key.dest ^ (std::uint64_t{key.algorithm} << 8 | key.heuristic))));
+        }
+    };
+
+    /// @brief Past this many pending edits, clearing is cheaper than replaying them.
+    static constexpr std::size_t kMaxJournal = 4096;
+
+    std::size_t capacity_;
+    std::uint64_t version_;
+    std::list<Entry> entries_;  // Most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+    std::unordered_map<std::uint64_t, std::vector<Key>> crossing_;  // Cell -> entries through it
+    std::vector<Edit> journal_;
+    bool overflow_ = false;
+    Stats stats_;
+    mutable std::mutex mutex_;
+
+    void erase(std::list<Entry>::iterator it) {
+        for (std::uint64_t cell : it->cells) {
+            auto found = crossing_.find(cell);
+            if (found == crossing_.end()) continue;
+            auto& keys = found->second;
+            auto key = std::find(keys.begin(), keys.end(), it->key);
+            if (key != keys.end()) {
+                *key = keys.back();
+                keys.pop_back();
+            }
+            if (keys.empty()) crossing_.erase(found);
+        }
+        index_.erase(it->key);
+        entries_.erase(it);
+    }
+
+    void drop_crossing(std::uint64_t cell) {
+        auto found = crossing_.find(cell);
+        if (found == crossing_.end()) return;
+        std::vector<Key> keys = std::move(found->second);
+        crossing_.erase(found);
+        for (const Key& key : keys) {
+            auto it = index_.find(key);
+            if (it == index_.end()) continue;
+            erase(it->second);
+            ++stats_.invalidations;
+        }
+    }
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "maze/maze.hpp"
+
+/// @brief Simple subgoal graph for fast repeated queries on open, uniform-cost maps.
+///
+/// A subgoal is a passage at a convex obstacle corner: a diagonal neighbour
+/// is blocked while the two cells beside that diagonal are open. Shortest
+/// paths only need to bend at subgoals. Two cells are h-reachable when a
+/// path as short as their Manhattan distance joins them. Each subgoal is
+/// linked to the subgoals it reaches that way without passing another one.
+/// Queries link the start and destination the same way, run A* over the
+/// subgoals, and refine each hop into monotone steps. Every passage must
+/// have the same weight. The graph is a snapshot: rebuild it after editing
+/// the maze.
+template <GraphCell G>
+class SubgoalGraph {
+public:
+    /// @brief Place subgoals and link them.
+    /// @param threads Worker count for linking (0 = hardware concurrency).
+    /// @throws std::invalid_argument if passages have different weights.
+    explicit SubgoalGraph(const GenericMaze<G>& maze, std::size_t threads = 0);
+
+    /// @brief Compute a shortest path through the subgoal graph.
+    /// @param expansions If non-null, receives the number of graph nodes expanded.
+    Path findPath(Cell start, Cell dest, std::size_t* expansions = nullptr) const;
+
+    /// @brief Number of subgoals.
+    std::size_t nodeCount() const { return nodes_.size(); }
+    /// @brief Number of links between subgoals.
+    std::size_t edgeCount() const { return edge_count_; }
+
+private:
+    static constexpr std::uint32_t npos = UINT32_MAX;
+
+    /// @brief Subgoal reached from another, with the steps between them.
+    struct Link {
+        std::uint32_t node;
+        std::uint32_t steps;
+        bool operator<(const Link& other) const { return node < other.node; }
+        bool operator==(const Link& other) const { return node == other.node; }
+    };
+
+    const GenericMaze<G>& maze_;
+    std::vector<Cell> nodes_;
+    /// @brief Links of each subgoal, sorted by node.
+    std::vector<std::vector<Link>> links_;
+    /// @brief Subgoal id of each cell (row-major), or npos.
+    std::vector<std::uint32_t> node_at_;
+    /// @brief Kind of each cell: 0 wall, 1 plain passage, 2 subgoal.
+    std::vector<std::uint8_t> kinds_;
+    /// @brief Per cell, how many cells from it leftward / rightward share its
+    /// kind, so scans skip whole runs.
+    std::vector<std::uint32_t> run_left_;
+    std::vector<std::uint32_t> run_right_;
+    std::size_t edge_count_ = 0;
+
+    std::size_t index_of(Cell cell) const { return cell.row * maze_.getWidth() + cell.col; }
+    bool passable(Cell cell) const { return !maze_.at_unchecked(cell).wall; }
+    bool is_subgoal(Cell cell) const;
+    int kind_of(Cell cell) const { return kinds_[index_of(cell)]; }
+    /// @brief Subgoals directly h-reachable from `origin`, plus whether
+    /// `target` is (pass `origin` to look for subgoals only).
+    std::vector<Link> direct_links(Cell origin, Cell target, bool& reaches_target) const;
+    /// @brief Visit (index, steps) for every subgoal, and `target`, that a
+    /// monotone path heading (row_step, col_step) reaches from `origin`
+    /// without passing either.
+    template <typename Visit>
+    void scan_quadrant(Cell origin, int row_step, int col_step, Cell target, Visit&& visit) const;
+    /// @brief Append a monotone path from `from` to `to`, which must be h-reachable.
+    void append_hop(Path& path, Cell from, Cell to) const;
+    /// @brief Append `from` -> `to` as one straight leg per axis if both legs are open.
+    bool append_bend(Path& path, Cell from, Cell to, bool rows_first) const;
+};
+
+#include "subgoal_graph.tpp"
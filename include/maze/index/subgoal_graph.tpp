@@ -0,0 +1,326 @@
+// subgoal_graph.tpp - Template implementations for SubgoalGraph
+// Included at the end of subgoal_graph.hpp
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "maze/core/parallel.hpp"
+
+template <GraphCell G>
+SubgoalGraph<G>::SubgoalGraph(const GenericMaze<G>& maze, std::size_t threads) : maze_(maze) {
+    const std::size_t width = maze_.getWidth();
+    const std::size_t height = maze_.getHeight();
+
+    // Links count steps, which is only the cost when every step costs the same
+    const G* first_passage = nullptr;
+    for (std::size_t row = 0; row < height; ++row) {
+        for (std::size_t col = 0; col < width; ++col) {
+            const G& cell = maze_.at_unchecked(Cell{row, col});
+            if (cell.wall) continue;
+            if (!first_passage) {
+                first_passage = &cell;
+            } else if (cell.weight != first_passage->weight) {
+                throw std::invalid_argument("Subgoal graphs need every passage to have the same weight");
+            }
+        }
+    }
+
+    node_at_.assign(width * height, npos);
+    kinds_.assign(width * height, 0);
+    for (std::size_t row = 0; row < height; ++row) {
+        for (std::size_t col = 0; col < width; ++col) {
+            Cell cell{row, col};
+            if (!passable(cell)) continue;
+            kinds_[index_of(cell)] = 1;
+            if (!is_subgoal(cell)) continue;
+            kinds_[index_of(cell)] = 2;
+            node_at_[index_of(cell)] = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.push_back(cell);
+        }
+    }
+
+    run_left_.assign(width * height, 1);
+    run_right_.assign(width * height, 1);
+    for (std::size_t row = 0; row < height; ++row) {
+        const std::size_t base = row * width;
+        for (std::size_t col = 1; col < width; ++col) {
+            if (kind_of({row, col}) == kind_of({row, col - 1})) {
+                run_left_[base + col] = run_left_[base + col - 1] + 1;
+            }
+        }
+        for (std::size_t col = width - 1; col-- > 0;) {
+            if (kind_of({row, col}) == kind_of({row, col + 1})) {
+                run_right_[base + col] = run_right_[base + col + 1] + 1;
+            }
+        }
+    }
+
+    links_.resize(nodes_.size());
+    parallel_for(nodes_.size(), threads, [&](std::size_t node) {
+        bool unused = false;
+        links_[node] = direct_links(nodes_[node], nodes_[node], unused);
+    });
+    // Direct h-reachability is symmetric, so every link is listed at both ends
+    for (const auto& links : links_) edge_count_ += links.size();
+    edge_count_ /= 2;
+}
+
+template <GraphCell G>
+bool SubgoalGraph<G>::is_subgoal(Cell cell) const {
+    if (!passable(cell)) return false;
+    const std::size_t width = maze_.getWidth();
+    const std::size_t height = maze_.getHeight();
+    for (Direction vertical : {Direction::up, Direction::down}) {
+        if (!cell.hasDir(vertical, width, height)) continue;
+        for (Direction horizontal : {Direction::left, Direction::right}) {
+            if (!cell.hasDir(horizontal, width, height)) continue;
+            const Cell side_a = cell.toward(vertical);
+            const Cell side_b = cell.toward(horizontal);
+            if (passable(side_a) && passable(side_b) && !passable(side_a.toward(horizontal))) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <GraphCell G>
+template <typename Visit>
+void SubgoalGraph<G>::scan_quadrant(Cell origin, int row_step, int col_step, Cell target,
+    Visit&& visit) const {
+    const std::size_t rows = row_step > 0 ? maze_.getHeight() - origin.row : origin.row + 1;
+    const std::size_t cols = col_step > 0 ? maze_.getWidth() - origin.col : origin.col + 1;
+    const std::vector<std::uint32_t>& runs = col_step > 0 ? run_right_ : run_left_;
+    const auto row_stride = static_cast<std::ptrdiff_t>(maze_.getWidth()) * row_step;
+    auto index_at = [&](std::size_t i, std::size_t j) {
+        return static_cast<std::size_t>(static_cast<std::ptrdiff_t>(index_of(origin))
+            + static_cast<std::ptrdiff_t>(i) * row_stride + static_cast<std::ptrdiff_t>(j) * col_step);
+    };
+    // Offset of the target in row i, or `cols` if it is not in that row
+    const bool target_ahead = col_step > 0 ? target.col >= origin.col : target.col <= origin.col;
+    const std::size_t target_i = row_step > 0 ? target.row - origin.row : origin.row - target.row;
+    const std::size_t target_j = col_step > 0 ? target.col - origin.col : origin.col - target.col;
+    auto target_offset = [&](std::size_t i) { return target_ahead && i == target_i ? target_j : cols; };
+    // First offset from j on that is not a plain passage, or is the target
+    auto stop_at = [&](std::size_t index, std::size_t j, std::size_t stop_j) {
+        std::size_t end = kinds_[index] == 1 ? j + runs[index] : j;
+        if (stop_j >= j && stop_j < end) end = stop_j;
+        return end;
+    };
+
+    // A cell continues the scan if it is reached, open, and neither a subgoal
+    // nor the target. Continuing cells of a row form runs [first, last); a
+    // cell below one of them is reached from above, and a reached plain cell
+    // reaches the cells to its side until something stops the run.
+    using Span = std::pair<std::size_t, std::size_t>;
+    std::vector<Span> above, below;
+
+    // The origin always continues, whatever it is
+    const std::size_t end = cols > 1 ? stop_at(index_at(0, 1), 1, target_offset(0)) : 1;
+    above.emplace_back(0, end);
+    if (end < cols && kinds_[index_at(0, end)] != 0) {
+        visit(index_at(0, end), static_cast<std::uint32_t>(end));
+    }
+
+    for (std::size_t i = 1; i < rows && !above.empty(); ++i) {
+        below.clear();
+        const std::size_t stop_j = target_offset(i);
+        const std::size_t row_index = index_at(i, 0);
+        auto index_in_row = [&](std::size_t j) {
+            return col_step > 0 ? row_index + j : row_index - j;
+        };
+        std::size_t done = 0;
+        for (auto [first, last] : above) {
+            for (std::size_t j = std::max(first, done); j < last;) {
+                const std::size_t index = index_in_row(j);
+                if (kinds_[index] == 0) {
+                    j += runs[index];
+                    continue;
+                }
+                const std::size_t stop = stop_at(index, j, stop_j);
+                if (stop > j) below.emplace_back(j, stop);
+                j = stop;
+                if (j < cols && kinds_[index_in_row(j)] != 0) {
+                    visit(index_in_row(j), static_cast<std::uint32_t>(i + j));
+                    ++j;
+                }
+                done = j;
+            }
+        }
+        above.swap(below);
+    }
+}
+
+template <GraphCell G>
+std::vector<typename SubgoalGraph<G>::Link> SubgoalGraph<G>::direct_links(Cell origin, Cell target,
+    bool& reaches_target) const {
+    std::vector<Link> links;
+    reaches_target = false;
+    for (int row_step : {-1, 1}) {
+        for (int col_step : {-1, 1}) {
+            scan_quadrant(origin, row_step, col_step, target, [&](std::size_t index, std::uint32_t steps) {
+                if (index == index_of(target)) reaches_target = true;
+                if (std::uint32_t id = node_at_[index]; id != npos) links.push_back({id, steps});
+            });
+        }
+    }
+    // Cells on the axes belong to two quadrants
+    std::sort(links.begin(), links.end());
+    links.erase(std::unique(links.begin(), links.end()), links.end());
+    return links;
+}
+
+template <GraphCell G>
+bool SubgoalGraph<G>::append_bend(Path& path, Cell from, Cell to, bool rows_first) const {
+    const std::size_t begin = path.size();
+    Cell cell = from;
+    auto leg = [&](bool vertical) {
+        while (vertical ? cell.row != to.row : cell.col != to.col) {
+            const Direction dir = vertical
+                ? (to.row > cell.row ? Direction::down : Direction::up)
+                : (to.col > cell.col ? Direction::right : Direction::left);
+            cell.move(dir);
+            if (!passable(cell)) return false;
+            path.push_back(dir);
+        }
+        return true;
+    };
+    if (leg(rows_first) && leg(!rows_first)) return true;
+    path.resize(begin);
+    return false;
+}
+
+template <GraphCell G>
+void SubgoalGraph<G>::append_hop(Path& path, Cell from, Cell to) const {
+    // Open maps usually allow a single bend; only search the box otherwise
+    if (append_bend(path, from, to, true) || append_bend(path, from, to, false)) return;
+
+    const bool down = to.row >= from.row;
+    const bool right = to.col >= from.col;
+    const std::size_t rows = (down ? to.row - from.row : from.row - to.row) + 1;
+    const std::size_t cols = (right ? to.col - from.col : from.col - to.col) + 1;
+
+    // Mark the cells of the bounding box that a monotone path reaches from `from`
+    std::vector<std::uint8_t> reached(rows * cols, 0);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            const Cell cell{down ? from.row + i : from.row - i, right ? from.col + j : from.col - j};
+            reached[i * cols + j] = passable(cell) && ((i == 0 && j == 0)
+                || (i > 0 && reached[(i - 1) * cols + j]) || (j > 0 && reached[i * cols + j - 1]));
+        }
+    }
+
+    // Walk back from `to` through reached cells
+    const std::size_t begin = path.size();
+    for (std::size_t i = rows - 1, j = cols - 1; i > 0 || j > 0;) {
+        if (i > 0 && reached[(i - 1) * cols + j]) {
+            path.push_back(down ? Direction::down : Direction::up);
+            --i;
+        } else {
+            path.push_back(right ? Direction::right : Direction::left);
+            --j;
+        }
+    }
+    std::reverse(path.begin() + static_cast<std::ptrdiff_t>(begin), path.end());
+}
+
+template <GraphCell G>
+Path SubgoalGraph<G>::findPath(Cell start, Cell dest, std::size_t* expansions) const {
+    if (expansions) *expansions = 0;
+    if (start == dest) return {};
+
+    const std::size_t width = maze_.getWidth();
+    const std::size_t height = maze_.getHeight();
+    if (start.row >= height || start.col >= width) return {};
+    if (dest.row >= height || dest.col >= width) return {};
+    if (!passable(start) || !passable(dest)) return {};
+
+    // Most queries on open maps need a single bend and no graph at all
+    Path path;
+    if (append_bend(path, start, dest, true) || append_bend(path, start, dest, false)) return path;
+
+    // Endpoints that are not subgoals become two extra nodes. If the
+    // destination is directly h-reachable, one monotone hop is the answer.
+    const auto count = static_cast<std::uint32_t>(nodes_.size());
+    std::uint32_t source = node_at_[index_of(start)];
+    std::uint32_t target = node_at_[index_of(dest)];
+    std::vector<Link> source_links;
+    if (source == npos) {
+        bool direct = false;
+        source_links = direct_links(start, dest, direct);
+        if (direct) {
+            append_hop(path, start, dest);
+            return path;
+        }
+        source = count;
+    }
+    std::vector<Link> target_links;
+    if (target == npos) {
+        bool unused = false;
+        target_links = direct_links(dest, dest, unused);
+        target = count + 1;
+    }
+
+    auto cell_of = [&](std::uint32_t node) {
+        return node < count ? nodes_[node] : (node == count ? start : dest);
+    };
+    auto estimate = [&](std::uint32_t node) {
+        const Cell cell = cell_of(node);
+        return static_cast<std::uint32_t>(
+            (cell.row > dest.row ? cell.row - dest.row : dest.row - cell.row)
+            + (cell.col > dest.col ? cell.col - dest.col : dest.col - cell.col));
+    };
+
+    std::vector<std::uint32_t> dist(count + 2, npos);
+    std::vector<std::uint32_t> parent(count + 2, npos);
+    // Ordered by f, then by the estimate, so ties go deepest first
+    using PQEntry = std::tuple<std::uint32_t, std::uint32_t, std::uint32_t>;
+    std::priority_queue<PQEntry, std::vector<PQEntry>, std::greater<PQEntry>> pq;
+
+    auto relax = [&](std::uint32_t from, std::uint32_t node, std::uint32_t cost) {
+        if (cost < dist[node]) {
+            dist[node] = cost;
+            parent[node] = from;
+            const std::uint32_t h = estimate(node);
+            pq.emplace(cost + h, h, node);
+        }
+    };
+
+    dist[source] = 0;
+    pq.emplace(estimate(source), estimate(source), source);
+    std::size_t expanded = 0;
+    while (!pq.empty()) {
+        auto [f, h, node] = pq.top();
+        pq.pop();
+        if (f != dist[node] + h) continue;  // Stale entry
+        ++expanded;
+        if (node == target) break;
+
+        const std::uint32_t d = dist[node];
+        for (const Link& link : node < count ? links_[node] : source_links) {
+            relax(node, link.node, d + link.steps);
+        }
+        if (node < count && !target_links.empty()) {
+            auto it = std::lower_bound(target_links.begin(), target_links.end(), Link{node, 0});
+            if (it != target_links.end() && it->node == node) relax(node, target, d + it->steps);
+        }
+    }
+
+    if (expansions) *expansions = expanded;
+    if (dist[target] == npos) return {};
+
+    std::vector<Cell> corners;
+    for (std::uint32_t node = target; node != npos; node = parent[node]) {
+        corners.push_back(cell_of(node));
+    }
+    path.reserve(dist[target]);
+    for (std::size_t i = corners.size() - 1; i > 0; --i) {
+        append_hop(path, corners[i], corners[i - 1]);
+    }
+    return path;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "maze/maze.hpp"
+
+/// @brief Exact path queries on perfect (cycle-free) mazes without searching.
+///
+/// Every generator in GenerationAlgorithm carves a spanning tree, so the path
+/// between two passages is unique. The index roots each tree, records depth
+/// and accumulated weight per cell, and answers lowest-common-ancestor queries
+/// in O(log n) through skew-binary jump pointers, which keep memory linear in
+/// the number of cells. The index is a snapshot: rebuild it after editing the maze.
+template <GraphCell G>
+class TreeIndex {
+public:
+    /// @brief Build the index; throws std::invalid_argument if passages form a cycle.
+    explicit TreeIndex(const GenericMaze<G>& maze);
+
+    /// @brief Check whether the passages of a maze form a forest.
+    static bool isPerfect(const GenericMaze<G>& maze);
+
+    /// @brief True if both cells are passages in the same tree.
+    bool connected(Cell a, Cell b) const;
+    /// @brief Number of steps on the unique path, if one exists.
+    std::optional<std::size_t> distance(Cell a, Cell b) const;
+    /// @brief Traversal cost of the unique path, if one exists.
+    std::optional<float> cost(Cell a, Cell b) const;
+    /// @brief Extract the unique path in O(path length).
+    Path findPath(Cell a, Cell b) const;
+
+private:
+    static constexpr std::uint32_t npos = UINT32_MAX;
+
+    std::size_t width_, height_;
+    /// @brief Tree id per cell, or npos for walls.
+    std::vector<std::uint32_t> component_;
+    std::vector<std::uint32_t> depth_;
+    /// @brief Skew-binary jump pointer per cell (root points to itself).
+    std::vector<std::uint32_t> jump_;
+    /// @brief Sum of weights from the root down to and including the cell.
+    std::vector<double> weighted_depth_;
+    /// @brief Direction from each cell toward its parent.
+    std::vector<Direction> up_;
+
+    std::uint32_t index_of(Cell cell) const {
+        return static_cast<std::uint32_t>(cell.row * width_ + cell.col);
+    }
+    Cell cell_of(std::uint32_t index) const { return {index / width_, index % width_}; }
+    std::uint32_t parent(std::uint32_t index) const;
+    bool valid(Cell cell) const;
+    std::uint32_t ancestor_at(std::uint32_t index, std::uint32_t depth) const;
+    std::uint32_t lca(std::uint32_t a, std::uint32_t b) const;
+};
+
+#include "tree_index.tpp"
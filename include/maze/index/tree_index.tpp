@@ -0,0 +1,194 @@
+// tree_index.tpp - Template implementations for TreeIndex
+// Included at the end of tree_index.hpp
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+template <GraphCell G>
+TreeIndex<G>::TreeIndex(const GenericMaze<G>& maze)
+    : width_(maze.getWidth()), height_(maze.getHeight()) {
+    const std::size_t cells = width_ * height_;
+    if (cells >= npos) {
+        throw std::length_error("Maze too large for TreeIndex");
+    }
+
+    component_.assign(cells, npos);
+    depth_.assign(cells, 0);
+    jump_.assign(cells, npos);
+    weighted_depth_.assign(cells, 0.0);
+    up_.assign(cells, Direction::COUNT);
+
+    std::vector<std::uint32_t> order;
+    order.reserve(cells);
+    std::uint32_t trees = 0;
+
+    for (std::uint32_t root = 0; root < cells; ++root) {
+        if (component_[root] != npos || maze.at_unchecked(cell_of(root)).wall) continue;
+
+        component_[root] = trees;
+        jump_[root] = root;
+        weighted_depth_[root] = maze.at_unchecked(cell_of(root)).weight;
+        std::size_t head = order.size();
+        order.push_back(root);
+
+        // BFS so every parent is finalized before its children
+        while (head < order.size()) {
+            std::uint32_t index = order[head++];
+            Cell cell = cell_of(index);
+
+            for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
+                Direction dir = static_cast<Direction>(d);
+                if (!cell.hasDir(dir, width_, height_)) continue;
+                Cell next = cell.toward(dir);
+                const G& data = maze.at_unchecked(next);
+                if (data.wall) continue;
+
+                std::uint32_t child = index_of(next);
+                if (component_[child] != npos) {
+                    if (dir != up_[index]) {
+                        throw std::invalid_argument(
+                            "Maze passages contain a cycle; TreeIndex requires a perfect maze");
+                    }
+                    continue;
+                }
+
+                component_[child] = trees;
+                up_[child] = reverse(dir);
+                depth_[child] = depth_[index] + 1;
+                weighted_depth_[child] = weighted_depth_[index] + data.weight;
+
+                // Skew-binary jump pointers: jump twice as far when the two
+                // jumps above the parent have equal length
+                std::uint32_t hop = jump_[index];
+                std::uint32_t hop2 = jump_[hop];
+                jump_[child] = (depth_[index] - depth_[hop] == depth_[hop] - depth_[hop2])
+                    ? hop2 : index;
+                order.push_back(child);
+            }
+        }
+        ++trees;
+    }
+}
+
+template <GraphCell G>
+bool TreeIndex<G>::isPerfect(const GenericMaze<G>& maze) {
+    const std::size_t width = maze.getWidth();
+    const std::size_t height = maze.getHeight();
+
+    std::vector<std::size_t> parent(width * height);
+    std::iota(parent.begin(), parent.end(), std::size_t{0});
+    auto find = [&](std::size_t x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+
+    for (std::size_t row = 0; row < height; ++row) {
+        for (std::size_t col = 0; col < width; ++col) {
+            if (maze.at_unchecked({row, col}).wall) continue;
+            std::size_t here = row * width + col;
+            if (col + 1 < width && !maze.at_unchecked({row, col + 1}).wall) {
+                std::size_t a = find(here), b = find(here + 1);
+                if (a == b) return false;
+                parent[a] = b;
+            }
+            if (row + 1 < height && !maze.at_unchecked({row + 1, col}).wall) {
+                std::size_t a = find(here), b = find(here + width);
+                if (a == b) return false;
+                parent[a] = b;
+            }
+        }
+    }
+    return true;
+}
+
+template <GraphCell G>
+std::uint32_t TreeIndex<G>::parent(std::uint32_t index) const {
+    if (up_[index] == Direction::COUNT) return index;
+    return index_of(cell_of(index).toward(up_[index]));
+}
+
+template <GraphCell G>
+bool TreeIndex<G>::valid(Cell cell) const {
+    return cell.row < height_ && cell.col < width_ && component_[index_of(cell)] != npos;
+}
+
+template <GraphCell G>
+std::uint32_t TreeIndex<G>::ancestor_at(std::uint32_t index, std::uint32_t depth) const {
+    while (depth_[index] > depth) {
+        index = depth_[jump_[index]] >= depth ? jump_[index] : parent(index);
+    }
+    return index;
+}
+
+template <GraphCell G>
+std::uint32_t TreeIndex<G>::lca(std::uint32_t a, std::uint32_t b) const {
+    if (depth_[a] > depth_[b]) a = ancestor_at(a, depth_[b]);
+    if (depth_[b] > depth_[a]) b = ancestor_at(b, depth_[a]);
+    // Equal depths imply equal jump lengths, so both sides can hop together
+    while (a != b) {
+        if (jump_[a] != jump_[b]) {
+            a = jump_[a];
+            b = jump_[b];
+        } else {
+            a = parent(a);
+            b = parent(b);
+        }
+    }
+    return a;
+}
+
+template <GraphCell G>
+bool TreeIndex<G>::connected(Cell a, Cell b) const {
+    return valid(a) && valid(b) && component_[index_of(a)] == component_[index_of(b)];
+}
+
+template <GraphCell G>
+std::optional<std::size_t> TreeIndex<G>::distance(Cell a, Cell b) const {
+    if (!connected(a, b)) return std::nullopt;
+    std::uint32_t ia = index_of(a), ib = index_of(b);
+    std::uint32_t top = lca(ia, ib);
+    return std::size_t{depth_[ia]} + depth_[ib] - 2 * std::size_t{depth_[top]};
+}
+
+template <GraphCell G>
+std::optional<float> TreeIndex<G>::cost(Cell a, Cell b) const {
+    if (!connected(a, b)) return std::nullopt;
+    std::uint32_t ia = index_of(a), ib = index_of(b);
+    std::uint32_t top = lca(ia, ib);
+
+    // Climbing enters every cell from a's parent up to the ancestor;
+    // descending enters every cell below the ancestor down to b
+    auto above = [this](std::uint32_t index) {
+        std::uint32_t up = parent(index);
+        return up == index ? 0.0 : weighted_depth_[up];
+    };
+    double climb = above(ia) - above(top);
+    double descend = weighted_depth_[ib] - weighted_depth_[top];
+    return static_cast<float>(climb + descend);
+}
+
+template <GraphCell G>
+Path TreeIndex<G>::findPath(Cell a, Cell b) const {
+    if (a == b || !connected(a, b)) return {};
+    std::uint32_t ia = index_of(a), ib = index_of(b);
+    std::uint32_t top = lca(ia, ib);
+
+    Path result;
+    result.reserve(depth_[ia] + depth_[ib] - 2 * depth_[top]);
+    for (std::uint32_t index = ia; index != top; index = parent(index)) {
+        result.push_back(up_[index]);
+    }
+
+    std::size_t split = result.size();
+    for (std::uint32_t index = ib; index != top; index = parent(index)) {
+        result.push_back(reverse(up_[index]));
+    }
+    std::reverse(result.begin() + static_cast<std::ptrdiff_t>(split), result.end());
+    return result;
+}
@@ -7,12 +7,32 @@
 #include <initializer_list>
 #include <random>
 #include <functional>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
 #include <unordered_set>
 
 #include "core/cell.hpp"
+#include "core/cell_id.hpp"
 #include "core/graph_cell.hpp"
 #include "core/cell_metadata.hpp"
+#include "core/cell_source.hpp"
 #include "core/direction.hpp"
+#include "core/exploration_trace.hpp"
+#include "core/frame_encoder.hpp"
+#include "core/alias_table.hpp"
+#include "core/parallel.hpp"
+#include "core/random.hpp"
+#include "core/trace.hpp"
+#include "index/component_index.hpp"
+#include "index/distance_matrix.hpp"
+#include "index/landmark_table.hpp"
+#include "index/path_cache.hpp"
 
 /// @brief Sequence of directions that forms a path through the maze.
 using Path = std::vector<Direction>;
@@ -30,7 +50,155 @@ enum class Algorithm {
     DFS,
     Dijkstra,
     AStar,
-    GreedyBestFirst
+    GreedyBestFirst,
+    /// @brief Anytime weighted A*: a fast inflated pass, then tighter ones within the budget.
+    ARAStar,
+    /// @brief Parallel bucketed shortest paths; same costs as Dijkstra.
+    DeltaStepping,
+    /// @brief Direction-optimizing level-synchronous BFS across threads.
+    ParallelBFS
+};
+
+/// @brief Every search engine, in declaration order.
+inline constexpr std::array<Algorithm, 8> kAllAlgorithms = {
+    Algorithm::BFS, Algorithm::DFS, Algorithm::Dijkstra, Algorithm::AStar,
+    Algorithm::GreedyBestFirst, Algorithm::ARAStar, Algorithm::DeltaStepping,
+    Algorithm::ParallelBFS
+};
+
+/// @brief Distance estimates used by the heuristic searches.
+enum class Heuristic {
+    Manhattan,
+    Euclidean,
+    /// @brief ALT bound from precomputed landmark tables (see buildLandmarks).
+    Landmarks
+};
+
+/// @brief Per-query knobs and observers for findPath.
+struct SearchOptions {
+    ExploreCallback on_explore = nullptr;
+    /// @brief Estimate used by A* and Greedy Best-First.
+    Heuristic heuristic = Heuristic::Manhattan;
+    /// @brief Worker count for parallel engines (0 = hardware concurrency).
+    std::size_t threads = 0;
+    /// @brief Bucket width for DeltaStepping (0 = largest passage weight).
+    float delta = 0.0f;
+    /// @brief If set, incremented once per expanded cell; safe to poll from other threads.
+    std::atomic<std::size_t>* expansions = nullptr;
+    /// @brief If set, every expanded cell is appended in order. Unlike
+    /// on_explore this costs a byte or two per expansion, not a frontier copy.
+    ExplorationTrace* trace = nullptr;
+    /// @brief Stop after this many expansions (0 = unlimited).
+    std::size_t max_expansions = 0;
+    /// @brief Stop once this time has passed.
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    /// @brief Stop as soon as this flag reads true; may be raised from another thread.
+    const std::atomic<bool>* cancel = nullptr;
+    /// @brief ARAStar: heuristic inflation of the first, fast pass (>= 1).
+    float initial_weight = 3.0f;
+    /// @brief ARAStar: how much the inflation drops between passes.
+    float weight_step = 0.5f;
+};
+
+/// @brief Why a search returned.
+enum class SearchStatus {
+    /// @brief The path reaches the destination.
+    Found,
+    /// @brief The search finished without reaching the destination.
+    NoPath,
+    /// @brief SearchOptions::max_expansions ran out first.
+    ExpansionLimit,
+    /// @brief SearchOptions::deadline passed first.
+    DeadlineExpired,
+    /// @brief SearchOptions::cancel was raised.
+    Cancelled
+};
+
+/// @brief Outcome of a budgeted search.
+struct SearchResult {
+    SearchStatus status = SearchStatus::NoPath;
+    /// @brief The full path when Found. After an interruption, the best path so
+    /// far: ARAStar may already reach the destination (see `bound`); other
+    /// engines stop at the expanded cell closest to it.
+    Path path;
+    /// @brief Cell the path ends at.
+    Cell reached{0, 0};
+    std::size_t expansions = 0;
+    /// @brief ARAStar: the path costs at most `bound` times the optimum (1 = optimal).
+    float bound = std::numeric_limits<float>::infinity();
+};
+
+/// @brief Per-query budget and best-so-far bookkeeping shared by the engines.
+class SearchControl {
+public:
+    /// @param dest Target used to rank partial results; nullopt for one-to-all runs.
+    SearchControl(const SearchOptions& options, std::optional<Cell> dest)
+        : options_(options), dest_(dest) {}
+
+    const SearchOptions& options() const { return options_; }
+
+    /// @brief Record expanding a cell; false once the budget says to stop.
+    bool expand(Cell cell) {
+        ++expansions_;
+        if (options_.expansions) options_.expansions->fetch_add(1, std::memory_order_relaxed);
+        if (options_.trace) options_.trace->record(cell);
+        if (dest_) {
+            std::size_t distance = (cell.row > dest_->row ? cell.row - dest_->row : dest_->row - cell.row)
+                + (cell.col > dest_->col ? cell.col - dest_->col : dest_->col - cell.col);
+            if (!best_ || distance < best_distance_) {
+                best_ = cell;
+                best_distance_ = distance;
+            }
+        }
+        return !interrupted();
+    }
+
+    /// @brief True once a budget has run out; latches.
+    bool interrupted() {
+        // Reading the clock costs more than the rest, so only sample it periodically
+        constexpr std::size_t kClockStride = 64;
+        if (stop_) return true;
+        if (options_.cancel && options_.cancel->load(std::memory_order_relaxed)) {
+            stop_ = SearchStatus::Cancelled;
+        } else if (options_.max_expansions && expansions_ >= options_.max_expansions) {
+            stop_ = SearchStatus::ExpansionLimit;
+        } else if (options_.deadline && expansions_ % kClockStride == 1
+                   && std::chrono::steady_clock::now() >= *options_.deadline) {
+            stop_ = SearchStatus::DeadlineExpired;
+        }
+        return stop_.has_value();
+    }
+
+    /// @brief Reason the search was cut short, if it was.
+    std::optional<SearchStatus> stopReason() const { return stop_; }
+    std::size_t expansions() const { return expansions_; }
+    /// @brief Expanded cell closest to the destination by Manhattan distance.
+    std::optional<Cell> best() const { return best_; }
+    float bound() const { return bound_; }
+    void setBound(float bound) { bound_ = bound; }
+
+private:
+    const SearchOptions& options_;
+    std::optional<Cell> dest_;
+    std::size_t expansions_ = 0;
+    std::optional<Cell> best_;
+    std::size_t best_distance_ = 0;
+    std::optional<SearchStatus> stop_;
+    float bound_ = std::numeric_limits<float>::infinity();
+};
+
+/// @brief One engine's run in a race. The counters may be polled while it
+/// runs; the remaining fields are valid once `finished` reads true.
+struct RaceEntry {
+    Algorithm algorithm = Algorithm::BFS;
+    std::atomic<std::size_t> expansions{0};
+    std::atomic<bool> finished{false};
+    Path path;
+    /// @brief Sum of entered-cell weights, infinity if no path was found.
+    float cost = std::numeric_limits<float>::infinity();
+    std::chrono::nanoseconds elapsed{0};
+    /// @brief Why the lane failed; empty if its engine ran to completion.
+    std::string error;
 };
 
 /// @brief Maze generation algorithms supported by the maze.
@@ -47,27 +215,79 @@ public:
     GenericMaze() = delete;
     /// @brief Construct a maze with the given dimensions.
     GenericMaze(std::size_t width, std::size_t height);
+    /// @brief Deep-copy the grid. Landmark tables are shared; component
+    /// tracking and path caching carry over but start empty.
+    GenericMaze(const GenericMaze& other);
+    /// @brief Take over another maze's grid, leaving it empty (0 x 0).
+    GenericMaze(GenericMaze&& other) noexcept;
+    /// @brief Dimensions are fixed, so mazes cannot be reassigned.
+    GenericMaze& operator=(const GenericMaze&) = delete;
+    GenericMaze& operator=(GenericMaze&&) = delete;
     /// @brief Release owned grid memory.
     ~GenericMaze();
 
     /// @brief Generate a random maze from a weighted cell pool.
     void generateRandom(std::vector<G>& cells, 
         float wall_density = 0.3f);
+    /// @brief Generate a reproducible random maze; the same seed gives the same
+    /// grid for any thread count.
+    /// @param threads Worker count for the fill (0 = hardware concurrency).
+    void generateRandom(std::vector<G>& cells, float wall_density,
+        std::uint64_t seed, std::size_t threads = 0);
     /// @brief Generate a random maze from a fixed initializer list.
     void generateRandom(std::initializer_list<G> cells,
         float wall_density = 0.3f);
     /// @brief Generate a perfect maze using a chosen algorithm.
     void generate(GenerationAlgorithm algorithm,
         const G& wall, const G& passage);
+    /// @brief Generate a perfect maze that is identical on every platform for a given seed.
+    void generate(GenerationAlgorithm algorithm,
+        const G& wall, const G& passage, std::uint64_t seed);
+    /// @brief Repaint every passage with a draw from `passages`, keeping walls.
+    /// @param frequencies Relative draw frequencies (empty = uniform).
+    void paintTerrain(const std::vector<G>& passages, std::uint64_t seed,
+        std::size_t threads = 0, const std::vector<float>& frequencies = {});
     /// @brief Compute a path without rendering.
     Path findPath(Algorithm algorithm,
         Cell start = {0, 0}, Cell dest = {0, 0},
         ExploreCallback on_explore = nullptr);
+    /// @brief Compute a path with explicit search options.
+    /// @return The path, or empty if none reached the destination within the
+    /// budget. A budget-cut ARAStar run may return a path that is not yet optimal.
+    Path findPath(Algorithm algorithm, Cell start, Cell dest,
+        const SearchOptions& options);
+    /// @brief Budgeted search that reports its status and a best-so-far path.
+    SearchResult search(Algorithm algorithm, Cell start, Cell dest,
+        const SearchOptions& options = {});
+    /// @brief One-to-all traversal costs via parallel Δ-stepping.
+    /// @return Row-major costs, infinity for unreachable cells.
+    std::vector<float> costMap(Cell source, std::size_t threads = 0,
+        float delta = 0.0f) const;
+    /// @brief One-to-all step counts via direction-optimizing parallel BFS.
+    /// @return Row-major levels, UINT32_MAX for unreachable cells.
+    std::vector<std::uint32_t> hopMap(Cell source, std::size_t threads = 0) const;
+    /// @brief Weighted costs between every pair of `points`: one Dijkstra per
+    /// point, run in parallel over the shared grid, each stopping once it has
+    /// settled every point it can reach.
+    /// @param threads Worker count (0 = hardware concurrency).
+    /// @param keep_paths Keep each search tree so DistanceMatrix::path works.
+    DistanceMatrix distanceMatrix(const std::vector<Cell>& points,
+        std::size_t threads = 0, bool keep_paths = false) const;
+    /// @brief Run one query through several engines at once, one thread each.
+    /// @param entries Pre-sized lanes with `algorithm` set; filled in as each finishes.
+    /// @param options Shared by every lane; on_explore, expansions and trace are ignored.
+    /// Options that some lane's engine rejects throw before any lane starts; a
+    /// lane that fails later records `error` and still sets `finished`.
+    void race(Cell start, Cell dest, std::vector<RaceEntry>& entries,
+        const SearchOptions& options = {});
+    /// @brief Race every engine in kAllAlgorithms and return their results.
+    std::vector<RaceEntry> race(Cell start, Cell dest, const SearchOptions& options = {});
     /// @brief Compute a path and optionally visualize it.
     bool solve(Algorithm algorithm,
         Cell start = {0, 0}, Cell dest = {0, 0},
         bool visualize = true);
 
+    /// @brief Write the grid as ANSI-colored rows in one write.
     template <GraphCell T>
     friend std::ostream& operator<<(std::ostream& os,
         const GenericMaze<T>& maze);
@@ -78,33 +298,101 @@ public:
     G& at_unchecked(Cell cell);
     /// @brief Unchecked access to a grid cell (const).
     const G& at_unchecked(Cell cell) const;
+    /// @brief Bounds-checked write that keeps derived indexes incrementally up to date.
+    void setCell(Cell cell, const G& value);
+
+    /// @brief Number of columns in the grid.
+    std::size_t getWidth() const { return width; }
+    /// @brief Number of rows in the grid.
+    std::size_t getHeight() const { return height; }
+
+    /// @brief Precompute ALT landmark tables for Heuristic::Landmarks. Any
+    /// later write to the grid drops them, so rebuild after editing.
+    /// @param threads Worker count for the table searches (0 = hardware concurrency).
+    void buildLandmarks(std::size_t count, std::size_t threads = 0);
+    /// @brief Install previously saved landmark tables; throws if they
+    /// were built for a different maze.
+    void setLandmarks(std::shared_ptr<const LandmarkTable> table);
+    /// @brief Currently installed landmark tables, if any.
+    std::shared_ptr<const LandmarkTable> landmarks() const { return landmarks_; }
+    /// @brief Hash of passability and weights, used to match saved indexes.
+    std::uint64_t fingerprint() const;
+
+    /// @brief Maintain connected-component labels so findPath and solve
+    /// reject unreachable destinations in O(1).
+    /// @param threads Worker count for label rebuilds (0 = hardware concurrency).
+    void trackComponents(bool enabled = true, std::size_t threads = 0);
+    /// @brief True if both cells are passages in the same region; requires trackComponents.
+    bool connected(Cell a, Cell b) const;
+
+    /// @brief Keep up to `capacity` findPath results in an LRU cache (0 = off).
+    /// Queries with on_explore, an expansions counter or a trace always run the search.
+    void cachePaths(std::size_t capacity);
+    /// @brief Hit, miss, eviction and invalidation counts (zeros when off).
+    PathCache::Stats pathCacheStats() const;
+    /// @brief Counter bumped by every write to the grid.
+    std::uint64_t version() const { return version_; }
 
 private:
-    const std::size_t width, height;
+    std::size_t width, height;
     G** grid;
+    std::shared_ptr<const LandmarkTable> landmarks_;
+    std::shared_ptr<ComponentIndex> components_;
+    std::shared_ptr<PathCache> path_cache_;
+    std::uint64_t version_ = 0;
 
     /// @brief Bounds-checked access to a grid cell (const).
     const G& at(Cell cell) const;
+    /// @brief Unchecked read for internal searches; unlike the non-const
+    /// at_unchecked it never reports an edit, whatever `this` is.
+    const G& cell_at(Cell cell) const { return grid[cell.row][cell.col]; }
+    /// @brief Record that any cell may have changed.
+    void invalidate();
+    /// @brief Record that one cell may change through a mutable reference.
+    void invalidate(Cell cell);
+    /// @brief Worker count for a whole-grid fill; small grids stay single-threaded.
+    std::size_t fill_threads(std::size_t requested) const;
+    /// @brief Throw for options `algo` cannot run with.
+    void check_options(Algorithm algo, const SearchOptions& options) const;
 
-    Path bfs(Cell start, Cell dest, ExploreCallback on_explore);
-    Path dfs(Cell start, Cell dest, ExploreCallback on_explore);
-    Path dijkstra(Cell start, Cell dest, ExploreCallback on_explore);
-    Path a_star(Cell start, Cell dest, ExploreCallback on_explore);
-    Path greedy_best_first(Cell start, Cell dest, ExploreCallback on_explore);
+    Path bfs(Cell start, Cell dest, SearchControl& control);
+    Path dfs(Cell start, Cell dest, SearchControl& control);
+    Path dijkstra(Cell start, Cell dest, SearchControl& control);
+    Path a_star(Cell start, Cell dest, SearchControl& control);
+    Path greedy_best_first(Cell start, Cell dest, SearchControl& control);
+    Path ara_star(Cell start, Cell dest, SearchControl& control);
+    /// @brief Single-source Dijkstra costs to every cell (infinity if unreachable).
+    std::vector<float> distances_from(Cell source) const;
+    float estimate(Heuristic heuristic, const Cell& from, const Cell& to) const;
+    void delta_stepping(Cell source, std::optional<Cell> dest, SearchControl& control,
+        std::vector<std::atomic<std::uint64_t>>& best) const;
+    Path delta_stepping_path(Cell start, Cell dest, SearchControl& control);
+    void parallel_bfs(Cell source, std::optional<Cell> dest, SearchControl& control,
+        std::vector<std::uint32_t>& level) const;
+    Path parallel_bfs_path(Cell start, Cell dest, SearchControl& control);
     void fill(const G& cell);
     void generate_recursive_backtracker(const G& wall, const G& passage,
-        std::mt19937& rng);
+        CounterRng& rng);
     void generate_prim(const G& wall, const G& passage,
-        std::mt19937& rng);
+        CounterRng& rng);
     void generate_kruskal(const G& wall, const G& passage,
-        std::mt19937& rng);
+        CounterRng& rng);
 
-    void displayPath(const Path& path, Cell start, Cell dest, 
+    /// @brief Animate `path` on the alternate screen, painting one step per
+    /// frame; each frame sends only the cell that step changed.
+    void displayPath(const Path& path, Cell start, Cell dest,
         const uint16_t step_ms = 100);
 };
 
 using Maze = GenericMaze<CellMetaData>;
 
 #include "maze.tpp"
+#include "algorithms/grid_search.tpp"
 #include "algorithms/pathfinding.tpp"
+#include "algorithms/ara_star.tpp"
 #include "algorithms/generation.tpp"
+#include "algorithms/landmarks.tpp"
+#include "algorithms/delta_stepping.tpp"
+#include "algorithms/parallel_bfs.tpp"
+#include "algorithms/distance_matrix.tpp"
+#include "algorithms/race.tpp"
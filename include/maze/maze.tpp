@@ -10,15 +10,46 @@
 #include <iostream>
 #include <vector>
 #include <initializer_list>
-#include <numeric>
+#include <optional>
+#include <utility>
 
 template <GraphCell G>
 GenericMaze<G>::GenericMaze(std::size_t width, std::size_t height)
-    : width(width), height(height), grid(new G*[height]) {
+    : width(width), height(height), grid(nullptr) {
+        // Searches index cells with 32-bit CellIds; the top value is reserved
+        if (height > 0 && width > (UINT32_MAX - 1) / height) {
+            throw std::length_error("Maze too large for 32-bit cell ids");
+        }
+        grid = new G*[height];
         for (std::size_t row = 0; row < height; ++row)
-            grid[row] = new G[width];
+            grid[row] = new G[width]();
 }
 
+template <GraphCell G>
+GenericMaze<G>::GenericMaze(const GenericMaze& other)
+    : GenericMaze(other.width, other.height) {
+    for (std::size_t row = 0; row < height; ++row) {
+        std::copy(other.grid[row], other.grid[row] + width, grid[row]);
+    }
+    version_ = other.version_;
+    landmarks_ = other.landmarks_;
+    // Both indexes are mutable per maze, so the copy gets fresh ones
+    if (other.components_) {
+        components_ = std::make_shared<ComponentIndex>(width, height, other.components_->threads());
+    }
+    if (other.path_cache_) cachePaths(other.path_cache_->capacity());
+}
+
+template <GraphCell G>
+GenericMaze<G>::GenericMaze(GenericMaze&& other) noexcept
+    : width(std::exchange(other.width, 0)),
+      height(std::exchange(other.height, 0)),
+      grid(std::exchange(other.grid, nullptr)),
+      landmarks_(std::move(other.landmarks_)),
+      components_(std::move(other.components_)),
+      path_cache_(std::move(other.path_cache_)),
+      version_(other.version_) {}
+
 template <GraphCell G>
 GenericMaze<G>::~GenericMaze() {
     for (std::size_t row = 0; row < height; ++row) {
@@ -29,6 +60,13 @@ GenericMaze<G>::~GenericMaze() {
 
 template <GraphCell G>
 void GenericMaze<G>::generateRandom(std::vector<G>& cells, float wall_density) {
+    std::random_device device;
+    generateRandom(cells, wall_density, (std::uint64_t{device()} << 32) | device());
+}
+
+template <GraphCell G>
+void GenericMaze<G>::generateRandom(std::vector<G>& cells, float wall_density,
+    std::uint64_t seed, std::size_t threads) {
     if (wall_density < 0.0f || wall_density > 1.0f)
         throw std::invalid_argument("Wall density must be in the range [0, 1]");
 
@@ -42,47 +80,56 @@ void GenericMaze<G>::generateRandom(std::vector<G>& cells, float wall_density) {
     // Erase walls from the original vector
     cells.erase(cells.begin(), first_non_wall);
 
-    static thread_local std::mt19937 gen(std::random_device{}());
-    std::bernoulli_distribution dist(wall_density);
-
-    // Helper to select a weighted random cell, with fallback to uniform if all weights are 0
-    auto select_weighted = [](const std::vector<G>& pool) -> G {
-        static thread_local std::mt19937 rng(std::random_device{}());
-
-        if (pool.empty()) {
-            throw std::invalid_argument("Cannot select from empty cell pool");
-        }
-
-        float total = std::accumulate(pool.begin(), pool.end(), 0.0f,
-            [](float sum, const G& c) { return sum + c.weight; });
-
-        if (total <= 0.0f) {
-            // Fallback: uniform random selection when all weights are 0
-            std::uniform_int_distribution<std::size_t> idx_dist(0, pool.size() - 1);
-            return pool[idx_dist(rng)];
-        }
+    if ((wall_density > 0.0f && wall_cells.empty())
+        || (wall_density < 1.0f && cells.empty())) {
+        throw std::invalid_argument("Cannot select from empty cell pool");
+    }
 
-        std::uniform_real_distribution<float> weight_dist(0.0f, total);
-        float r = weight_dist(rng);
-        for (const auto& c : pool) {
-            r -= c.weight;
-            if (r <= 0.0f) {
-                return c;
-            }
-        }
-        // Fallback in case of floating-point rounding issues
-        return pool.back();
+    // Cells are drawn with probability proportional to weight (uniform if all
+    // weights are 0). An alias table makes each draw O(1) instead of O(pool).
+    auto weights_of = [](const std::vector<G>& pool) {
+        std::vector<float> weights;
+        weights.reserve(pool.size());
+        for (const G& c : pool) weights.push_back(c.weight);
+        return weights;
+    };
+    auto build_table = [&](const std::vector<G>& pool) {
+        return pool.empty() ? std::nullopt : std::optional<AliasTable>(weights_of(pool));
     };
+    const std::optional<AliasTable> wall_table = build_table(wall_cells);
+    const std::optional<AliasTable> passage_table = build_table(cells);
 
-    for (std::size_t row = 0; row < height; ++row) {
+    invalidate();
+    // Every cell draws from its own counter, so the map depends only on the seed
+    parallel_for(height, fill_threads(threads), [&](std::size_t row) {
         for (std::size_t col = 0; col < width; ++col) {
-            if (dist(gen)) {
-                grid[row][col] = select_weighted(wall_cells);
+            const std::uint64_t index = row * width + col;
+            if (unit_float(random_at(seed, 0, index)) < wall_density) {
+                grid[row][col] = wall_cells[wall_table->sample(random_at(seed, 1, index))];
             } else {
-                grid[row][col] = select_weighted(cells);
+                grid[row][col] = cells[passage_table->sample(random_at(seed, 1, index))];
             }
         }
+    });
+}
+
+template <GraphCell G>
+void GenericMaze<G>::paintTerrain(const std::vector<G>& passages, std::uint64_t seed,
+    std::size_t threads, const std::vector<float>& frequencies) {
+    if (passages.empty()) throw std::invalid_argument("Cannot select from empty cell pool");
+    if (!frequencies.empty() && frequencies.size() != passages.size()) {
+        throw std::invalid_argument("Terrain frequencies must match the passage pool");
     }
+    const AliasTable table(frequencies.empty()
+        ? std::vector<float>(passages.size(), 1.0f) : frequencies);
+
+    invalidate();
+    parallel_for(height, fill_threads(threads), [&](std::size_t row) {
+        for (std::size_t col = 0; col < width; ++col) {
+            if (grid[row][col].wall) continue;
+            grid[row][col] = passages[table.sample(random_at(seed, 2, row * width + col))];
+        }
+    });
 }
 
 template <GraphCell G>
@@ -94,25 +141,102 @@ void GenericMaze<G>::generateRandom(std::initializer_list<G> cells, float wall_d
 template <GraphCell G>
 Path GenericMaze<G>::findPath(Algorithm algo, Cell start, Cell dest,
     ExploreCallback on_explore) {
+    SearchOptions options;
+    options.on_explore = std::move(on_explore);
+    return findPath(algo, start, dest, options);
+}
+
+template <GraphCell G>
+Path GenericMaze<G>::findPath(Algorithm algo, Cell start, Cell dest,
+    const SearchOptions& options) {
+    if (start == Cell{0, 0} && dest == Cell{0, 0}) {
+        dest = {height - 1, width - 1};
+    }
+
+    // Observers expect the search to actually run, and a budgeted run may
+    // return an answer that is not the one the cache key promises
+    const bool budgeted = options.max_expansions || options.deadline || options.cancel;
+    if (!path_cache_ || budgeted || options.on_explore || options.expansions || options.trace) {
+        SearchResult result = search(algo, start, dest, options);
+        if (!(result.reached == dest)) return {};
+        return std::move(result.path);
+    }
+    if (path_cache_->version() != version_) {
+        path_cache_->reconcile(version_, [this](std::uint64_t index) {
+            const G& cell = grid[index / width][index % width];
+            return std::pair<bool, float>(cell.wall, cell.weight);
+        });
+    }
+    const PathCache::Key key{start.row * width + start.col, dest.row * width + dest.col,
+        static_cast<std::uint8_t>(algo), static_cast<std::uint8_t>(options.heuristic)};
+    if (auto cached = path_cache_->find(key)) return std::move(*cached);
+
+    SearchResult result = search(algo, start, dest, options);
+    // Only complete answers are reusable; a budget cut or an unproven ARA*
+    // path is not an answer
+    if (result.status != SearchStatus::Found && result.status != SearchStatus::NoPath) return {};
+    if (algo == Algorithm::ARAStar && result.status == SearchStatus::Found && result.bound > 1.0f) {
+        return std::move(result.path);
+    }
+    std::vector<std::uint64_t> cells{key.start};
+    for (Cell current = start; Direction dir : result.path) {
+        current.move(dir);
+        cells.push_back(current.row * width + current.col);
+    }
+    path_cache_->insert(key, result.path, std::move(cells));
+    if (result.status != SearchStatus::Found) return {};
+    return std::move(result.path);
+}
+
+template <GraphCell G>
+SearchResult GenericMaze<G>::search(Algorithm algo, Cell start, Cell dest,
+    const SearchOptions& options) {
     // Use default destination if sentinel value is passed
     if (start == Cell{0, 0} && dest == Cell{0, 0}) {
         dest = {height - 1, width - 1};
     }
 
+    SearchResult result;
+    result.reached = start;
     if (start == dest) {
-        return {};
+        result.status = SearchStatus::Found;
+        return result;
+    }
+
+    if (components_ && !connected(start, dest)) {
+        return result;
     }
 
-    return [&] {
+    check_options(algo, options);
+
+    SearchControl control(options, dest);
+    result.path = [&] {
         switch (algo) {
-            case Algorithm::BFS:      return bfs(start, dest, on_explore);
-            case Algorithm::DFS:      return dfs(start, dest, on_explore);
-            case Algorithm::Dijkstra: return dijkstra(start, dest, on_explore);
-            case Algorithm::AStar:    return a_star(start, dest, on_explore);
+            case Algorithm::BFS:      return bfs(start, dest, control);
+            case Algorithm::DFS:      return dfs(start, dest, control);
+            case Algorithm::Dijkstra: return dijkstra(start, dest, control);
+            case Algorithm::AStar:    return a_star(start, dest, control);
             case Algorithm::GreedyBestFirst:
-                return greedy_best_first(start, dest, on_explore);
+                return greedy_best_first(start, dest, control);
+            case Algorithm::ARAStar:  return ara_star(start, dest, control);
+            case Algorithm::DeltaStepping:
+                return delta_stepping_path(start, dest, control);
+            case Algorithm::ParallelBFS:
+                return parallel_bfs_path(start, dest, control);
         }
     }();
+
+    for (Direction dir : result.path) result.reached.move(dir);
+    result.expansions = control.expansions();
+    result.bound = control.bound();
+    // A budget cut wins even if an anytime engine already reaches the
+    // destination; `reached` and `bound` say how good that path is
+    if (control.stopReason()) {
+        result.status = *control.stopReason();
+    } else if (result.reached == dest) {
+        result.status = SearchStatus::Found;
+    }
+    return result;
 }
 
 template <GraphCell G>
@@ -134,15 +258,9 @@ bool GenericMaze<G>::solve(Algorithm algo, Cell start, Cell dest, bool visualize
 
 template <GraphCell G>
 std::ostream& operator<<(std::ostream& os, const GenericMaze<G>& maze) {
-    for (std::size_t row = 0; row < maze.height; ++row) {
-        for (std::size_t col = 0; col < maze.width; ++col) {
-            G cell = maze.grid[row][col];
-            os << "\033[38;5;" << static_cast<int>(cell.color)
-               << "m" << cell.glyph << "\033[0m" << ' ';
-        }
-        os << '\n';
-    }
-    return os;
+    AnsiFrameEncoder encoder;
+    std::string_view text = encoder.full(maze);
+    return os.write(text.data(), static_cast<std::streamsize>(text.size()));
 }
 
 template <GraphCell G>
@@ -152,9 +270,97 @@ G& GenericMaze<G>::operator[](Cell cell) {
             + std::to_string(cell.col) + ") out of bounds for maze of size "
             + std::to_string(width) + "x" + std::to_string(height));
     }
+    invalidate(cell);
     return grid[cell.row][cell.col];
 }
 
+template <GraphCell G>
+void GenericMaze<G>::setCell(Cell cell, const G& value) {
+    at(cell);  // Bounds check
+    G& slot = grid[cell.row][cell.col];
+    ++version_;
+    landmarks_.reset();
+    if (path_cache_) path_cache_->noteEdit(cell.row * width + cell.col, slot.wall, slot.weight);
+    bool opened = slot.wall && !value.wall;
+    bool closed = !slot.wall && value.wall;
+    slot = value;
+    if (!components_) return;
+    if (closed) {
+        components_->invalidate();
+    } else if (opened) {
+        components_->open(cell.row * width + cell.col,
+            [this](std::size_t index) { return grid[index / width][index % width].wall; });
+    }
+}
+
+template <GraphCell G>
+void GenericMaze<G>::trackComponents(bool enabled, std::size_t threads) {
+    components_ = enabled ? std::make_shared<ComponentIndex>(width, height, threads) : nullptr;
+}
+
+template <GraphCell G>
+bool GenericMaze<G>::connected(Cell a, Cell b) const {
+    if (!components_) {
+        throw std::logic_error("Component tracking is disabled; call trackComponents first");
+    }
+    if (a.row >= height || a.col >= width || b.row >= height || b.col >= width) return false;
+    components_->refresh(
+        [this](std::size_t index) { return grid[index / width][index % width].wall; });
+    return components_->connected(a.row * width + a.col, b.row * width + b.col);
+}
+
+template <GraphCell G>
+void GenericMaze<G>::cachePaths(std::size_t capacity) {
+    path_cache_ = capacity > 0 ? std::make_shared<PathCache>(capacity, version_) : nullptr;
+}
+
+template <GraphCell G>
+PathCache::Stats GenericMaze<G>::pathCacheStats() const {
+    return path_cache_ ? path_cache_->stats() : PathCache::Stats{};
+}
+
+template <GraphCell G>
+void GenericMaze<G>::invalidate() {
+    ++version_;
+    // Old distances can overstate the new ones, which makes ALT inadmissible
+    landmarks_.reset();
+    if (components_) components_->invalidate();
+    if (path_cache_) path_cache_->noteReset();
+}
+
+template <GraphCell G>
+void GenericMaze<G>::invalidate(Cell cell) {
+    ++version_;
+    landmarks_.reset();
+    if (components_) components_->invalidate();
+    if (path_cache_) {
+        const G& slot = grid[cell.row][cell.col];
+        path_cache_->noteEdit(cell.row * width + cell.col, slot.wall, slot.weight);
+    }
+}
+
+template <GraphCell G>
+void GenericMaze<G>::check_options(Algorithm algo, const SearchOptions& options) const {
+    if (options.heuristic == Heuristic::Landmarks && !landmarks_) {
+        throw std::logic_error("Landmark heuristic requires buildLandmarks or setLandmarks");
+    }
+    if (algo == Algorithm::ARAStar) {
+        if (!(options.initial_weight >= 1.0f)) {
+            throw std::invalid_argument("ARA* initial weight must be at least 1");
+        }
+        if (!(options.weight_step > 0.0f)) {
+            throw std::invalid_argument("ARA* weight step must be positive");
+        }
+    }
+}
+
+template <GraphCell G>
+std::size_t GenericMaze<G>::fill_threads(std::size_t requested) const {
+    // Below this many cells, starting workers costs more than the fill itself
+    constexpr std::size_t kMinParallelCells = std::size_t{1} << 16;
+    return width * height < kMinParallelCells ? 1 : requested;
+}
+
 template <GraphCell G>
 const G& GenericMaze<G>::at(Cell cell) const {
     if (cell.row >= height || cell.col >= width) {
@@ -167,26 +373,29 @@ const G& GenericMaze<G>::at(Cell cell) const {
 
 template <GraphCell G>
 G& GenericMaze<G>::at_unchecked(Cell cell) {
+    invalidate(cell);
     return grid[cell.row][cell.col];
 }
 
 template <GraphCell G>
 const G& GenericMaze<G>::at_unchecked(Cell cell) const {
-    return grid[cell.row][cell.col];
+    return cell_at(cell);
 }
 
 template <GraphCell G>
 void GenericMaze<G>::displayPath(const Path& path, Cell start, Cell dest, const uint16_t step_ms) {
     (void)dest;
-    std::cout << "\033[?1049h\033[?25l\033[H\033[2J";  // Alt screen + hide cursor + clear
+    std::cout << "\033[?1049h\033[?25l";  // Alt screen + hide cursor
+    // The first frame draws the maze; each later one rewrites the painted cell
+    AnsiFrameEncoder encoder;
     for (const Direction& dir : path) {
-        std::cout << "\033[H";
         // Modify cell properties directly (works with any GraphCell type)
         G& cell = at_unchecked(start);
         cell.glyph = DirectionGlyphs[dir];
         cell.color = Color::white;
         cell.wall = false;
-        std::cout << *this << std::flush;
+        std::string_view frame = encoder.frame(*this, std::span<const Cell>(&start, 1));
+        std::cout.write(frame.data(), static_cast<std::streamsize>(frame.size())).flush();
         start.move(dir);
         std::this_thread::sleep_for(std::chrono::milliseconds(step_ms));
     }
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "maze.hpp"
+
+/// @brief Perfect-maze layouts that can be evaluated one cell at a time.
+enum class ProceduralLayout {
+    /// @brief Every node links north or west; long corridors on the top row and left column.
+    BinaryTree,
+    /// @brief Row runs that each link north once; less biased than BinaryTree.
+    Sidewinder
+};
+
+/// @brief Maze whose cells are a pure function of (seed, row, col).
+///
+/// Nothing is stored per cell, so the dimensions can be far larger than any
+/// grid that fits in memory. Nodes sit on odd rows and columns as in the
+/// perfect-maze generators; each layout decides locally which links between
+/// nodes are open, and passages draw their terrain from a seeded alias table.
+/// BFS and A* run through the shared CellSource engines with sparse state,
+/// so a query's memory grows with the area it explores.
+template <GraphCell G>
+class GenericProceduralMaze {
+public:
+    /// @brief Describe a width x height maze; no cells are computed up front.
+    /// @param frequencies Relative draw frequencies for `passages` (empty = uniform).
+    GenericProceduralMaze(std::size_t width, std::size_t height, std::uint64_t seed,
+        const G& wall, std::vector<G> passages,
+        ProceduralLayout layout = ProceduralLayout::Sidewinder,
+        const std::vector<float>& frequencies = {});
+
+    /// @brief Number of columns.
+    std::size_t getWidth() const { return width_; }
+    /// @brief Number of rows.
+    std::size_t getHeight() const { return height_; }
+    /// @brief Seed the layout and terrain derive from.
+    std::uint64_t seed() const { return seed_; }
+
+    /// @brief Contents of a cell, computed on every call.
+    G at_unchecked(Cell cell) const;
+    /// @brief Bounds-checked contents of a cell.
+    G cellAt(Cell cell) const;
+
+    /// @brief Search the maze without materializing it.
+    /// Supports BFS and AStar (Manhattan or Euclidean); other engines need a
+    /// stored grid and throw std::invalid_argument.
+    Path findPath(Algorithm algorithm, Cell start, Cell dest,
+        const SearchOptions& options = {}) const;
+    /// @brief Budgeted search that reports its status and a best-so-far path.
+    SearchResult search(Algorithm algorithm, Cell start, Cell dest,
+        const SearchOptions& options = {}) const;
+
+private:
+    /// @brief Longest Sidewinder run, so resolving a link scans a bounded span.
+    static constexpr std::size_t kMaxRun = 16;
+
+    std::size_t width_, height_;
+    std::uint64_t seed_;
+    G wall_;
+    std::vector<G> passages_;
+    ProceduralLayout layout_;
+    AliasTable terrain_;
+    std::size_t node_rows_, node_cols_;
+
+    bool passable(std::size_t row, std::size_t col) const;
+    /// @brief True if node (i, j) links to node (i, j + 1).
+    bool links_east(std::size_t i, std::size_t j) const;
+    /// @brief True if node (i, j) links to node (i - 1, j).
+    bool links_north(std::size_t i, std::size_t j) const;
+    /// @brief Sidewinder: true if the run containing node (i, j) ends there.
+    bool closes_run(std::size_t i, std::size_t j) const;
+    std::uint64_t draw(std::uint64_t stream, std::size_t row, std::size_t col) const;
+};
+
+using ProceduralMaze = GenericProceduralMaze<CellMetaData>;
+
+#include "procedural_maze.tpp"
@@ -0,0 +1,139 @@
+// procedural_maze.tpp - Template implementations for GenericProceduralMaze
+// Included at the end of procedural_maze.hpp
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+template <GraphCell G>
+GenericProceduralMaze<G>::GenericProceduralMaze(std::size_t width, std::size_t height,
+    std::uint64_t seed, const G& wall, std::vector<G> passages, ProceduralLayout layout,
+    const std::vector<float>& frequencies)
+    : width_(width),
+      height_(height),
+      seed_(seed),
+      wall_(wall),
+      passages_(std::move(passages)),
+      layout_(layout),
+      terrain_(frequencies.empty() ? std::vector<float>(passages_.size(), 1.0f) : frequencies),
+      node_rows_(height > 0 ? (height - 1) / 2 : 0),
+      node_cols_(width > 0 ? (width - 1) / 2 : 0) {
+    if (!frequencies.empty() && frequencies.size() != passages_.size()) {
+        throw std::invalid_argument("Terrain frequencies must match the passage pool");
+    }
+}
+
+template <GraphCell G>
+std::uint64_t GenericProceduralMaze<G>::draw(std::uint64_t stream,
+    std::size_t row, std::size_t col) const {
+    return random_at(seed_ ^ mix64(row), stream, col);
+}
+
+template <GraphCell G>
+bool GenericProceduralMaze<G>::closes_run(std::size_t i, std::size_t j) const {
+    return j + 1 == node_cols_ || (j + 1) % kMaxRun == 0 || (draw(0, i, j) & 1);
+}
+
+template <GraphCell G>
+bool GenericProceduralMaze<G>::links_east(std::size_t i, std::size_t j) const {
+    if (j + 1 >= node_cols_) return false;
+    if (layout_ == ProceduralLayout::BinaryTree) {
+        // Node (i, j + 1) links west unless it sits in the left column or wins the coin for north
+        return i == 0 || !(draw(0, i, j + 1) & 1);
+    }
+    return i == 0 || !closes_run(i, j);
+}
+
+template <GraphCell G>
+bool GenericProceduralMaze<G>::links_north(std::size_t i, std::size_t j) const {
+    if (i == 0) return false;
+    if (layout_ == ProceduralLayout::BinaryTree) {
+        return j == 0 || (draw(0, i, j) & 1);
+    }
+
+    // Each run links north from exactly one of its nodes, picked from the run's last node
+    std::size_t first = j;
+    while (first > 0 && !closes_run(i, first - 1)) --first;
+    std::size_t last = j;
+    while (!closes_run(i, last)) ++last;
+    std::uint64_t span = last - first + 1;
+    return first + static_cast<std::size_t>(((draw(1, i, last) >> 32) * span) >> 32) == j;
+}
+
+template <GraphCell G>
+bool GenericProceduralMaze<G>::passable(std::size_t row, std::size_t col) const {
+    if (row == 0 || col == 0 || row >= 2 * node_rows_ || col >= 2 * node_cols_) return false;
+    const bool odd_row = row % 2 == 1;
+    const bool odd_col = col % 2 == 1;
+    if (odd_row && odd_col) return true;    // Node
+    if (!odd_row && !odd_col) return false;  // Pillar between nodes
+    if (odd_row) return links_east((row - 1) / 2, col / 2 - 1);
+    return links_north(row / 2, (col - 1) / 2);
+}
+
+template <GraphCell G>
+G GenericProceduralMaze<G>::at_unchecked(Cell cell) const {
+    if (!passable(cell.row, cell.col)) return wall_;
+    return passages_[terrain_.sample(draw(2, cell.row, cell.col))];
+}
+
+template <GraphCell G>
+G GenericProceduralMaze<G>::cellAt(Cell cell) const {
+    if (cell.row >= height_ || cell.col >= width_) {
+        throw std::out_of_range("Cell (" + std::to_string(cell.row) + ", "
+            + std::to_string(cell.col) + ") out of bounds for maze of size "
+            + std::to_string(width_) + "x" + std::to_string(height_));
+    }
+    return at_unchecked(cell);
+}
+
+template <GraphCell G>
+Path GenericProceduralMaze<G>::findPath(Algorithm algorithm, Cell start, Cell dest,
+    const SearchOptions& options) const {
+    SearchResult result = search(algorithm, start, dest, options);
+    if (result.status != SearchStatus::Found) return {};
+    return std::move(result.path);
+}
+
+template <GraphCell G>
+SearchResult GenericProceduralMaze<G>::search(Algorithm algorithm, Cell start, Cell dest,
+    const SearchOptions& options) const {
+    cellAt(start);  // Bounds checks
+    cellAt(dest);
+
+    SearchResult result;
+    result.reached = start;
+    if (start == dest) {
+        result.status = SearchStatus::Found;
+        return result;
+    }
+
+    SearchControl control(options, dest);
+    SparseSearchState state(width_);
+    switch (algorithm) {
+        case Algorithm::BFS:
+            result.path = grid_bfs(*this, start, dest, control, state);
+            break;
+        case Algorithm::AStar:
+            if (options.heuristic == Heuristic::Landmarks) {
+                throw std::invalid_argument("Landmark heuristic needs a stored maze");
+            }
+            result.path = grid_a_star(*this, start, dest, control, state,
+                [&](const Cell& from, const Cell& to) {
+                    return options.heuristic == Heuristic::Euclidean
+                        ? euclidean_distance(from, to) : manhattan_distance(from, to);
+                });
+            break;
+        default:
+            throw std::invalid_argument("Procedural mazes support BFS and AStar only");
+    }
+
+    for (Direction dir : result.path) result.reached.move(dir);
+    result.expansions = control.expansions();
+    if (result.reached == dest) {
+        result.status = SearchStatus::Found;
+    } else if (control.stopReason()) {
+        result.status = *control.stopReason();
+    }
+    return result;
+}
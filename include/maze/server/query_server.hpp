@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "maze/maze.hpp"
+
+namespace maze::server {
+
+/// @brief Lock-free latency histogram with power-of-two microsecond buckets.
+class LatencyHistogram {
+public:
+    /// @brief Bucket i counts latencies below 2^i microseconds (the last is open).
+    static constexpr std::size_t kBuckets = 32;
+
+    void record(std::uint64_t micros);
+    std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    std::uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+    /// @brief Upper bound, in microseconds, of the bucket holding quantile `q`.
+    std::uint64_t percentile(double q) const;
+    /// @brief Append this histogram as a JSON object.
+    void writeJson(std::string& out) const;
+
+private:
+    std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+/// @brief Answers newline-delimited JSON queries against one warm maze.
+///
+/// Each request is a JSON object on one line; each response is one line that
+/// echoes the request's "id". Ops:
+///   {"op":"path","algorithm":"astar","start":[r,c],"dest":[r,c]}
+///     optional "heuristic", "max_expansions", "timeout_ms", "threads"
+///     (capped at the core count), "path" (false omits the directions)
+///   {"op":"connected","a":[r,c],"b":[r,c]}  (needs component tracking)
+///   {"op":"info"}, {"op":"stats"}
+/// Requests are handled by a worker pool in batches, so responses come back
+/// in completion order, not request order. The maze must not be edited while
+/// the server runs; queries only read it and its indexes.
+class QueryServer {
+public:
+    /// @brief Largest number of queued requests a worker takes at once.
+    static constexpr std::size_t kMaxBatch = 32;
+    /// @brief Longest request line a socket client may send; longer ones get
+    /// an error and the connection is closed.
+    static constexpr std::size_t kMaxLineBytes = std::size_t{1} << 20;
+
+    /// @param workers Pool size (0 = hardware concurrency).
+    QueryServer(Maze& maze, std::size_t workers = 0);
+    /// @brief Drain queued requests and stop the workers.
+    ~QueryServer();
+
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    /// @brief Answer one request line synchronously; safe from any thread.
+    std::string handle(std::string_view line);
+
+    /// @brief Pipeline every line of `in` through the pool, writing responses
+    /// to `out` as they finish. Returns after EOF once all are answered.
+    void serve(std::istream& in, std::ostream& out);
+    /// @brief Accept connections on a Unix domain socket, one reader thread per
+    /// client, until `stop` reads true. Throws std::runtime_error on setup failure.
+    void serveSocket(const std::string& path, const std::atomic<bool>& stop);
+
+    /// @brief Per-op latency, from a request being read to its response being ready.
+    std::string statsJson() const;
+
+private:
+    /// @brief Where one client's responses go, and how many are outstanding.
+    struct Sink {
+        std::function<void(const std::string&)> write;
+        std::mutex mutex;
+        std::condition_variable idle;
+        std::size_t pending = 0;
+    };
+    struct Job {
+        std::string line;
+        std::shared_ptr<Sink> sink;
+        std::chrono::steady_clock::time_point received;
+    };
+    enum Op : std::size_t { PathOp, ConnectedOp, InfoOp, StatsOp, InvalidOp, kOpCount };
+
+    void submit(std::string line, const std::shared_ptr<Sink>& sink);
+    /// @brief Block until every request submitted through `sink` is answered.
+    void drain(Sink& sink);
+    void worker_loop();
+    std::string answer(std::string_view line, Op& op);
+
+    Maze& maze_;
+    const std::size_t worker_count_;
+    std::vector<std::thread> workers_;
+    std::deque<Job> queue_;
+    std::mutex queue_mutex_;
+    std::condition_variable queue_ready_;
+    bool stopping_ = false;
+    std::array<LatencyHistogram, kOpCount> latency_;
+};
+
+}  // namespace maze::server
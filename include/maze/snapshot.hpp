@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "maze.hpp"
+
+template <GraphCell G>
+class GenericMazeEditor;
+
+/// @brief Immutable, versioned copy of a maze stored as square tiles.
+///
+/// Snapshots are handed out as shared_ptr<const ...>, so any number of
+/// threads can search one while an editor prepares the next. Tiles are
+/// reference counted and shared between snapshots: an edit copies only the
+/// tiles it writes, and a new version costs one pointer per tile plus the
+/// touched tiles. BFS, Dijkstra and A* run through the shared CellSource
+/// engines.
+template <GraphCell G>
+class GenericMazeSnapshot {
+public:
+    /// @brief Cells per tile side; a power of two so lookups are shifts and masks.
+    static constexpr std::size_t kTileShift = 6;
+    static constexpr std::size_t kTileSide = std::size_t{1} << kTileShift;
+
+    /// @brief Copy a maze's cells; the snapshot takes the maze's version.
+    explicit GenericMazeSnapshot(const GenericMaze<G>& maze);
+
+    /// @brief Number of columns.
+    std::size_t getWidth() const { return width_; }
+    /// @brief Number of rows.
+    std::size_t getHeight() const { return height_; }
+    /// @brief Version this snapshot was taken at; each commit adds one.
+    std::uint64_t version() const { return version_; }
+
+    /// @brief Unchecked access to a cell.
+    const G& at_unchecked(Cell cell) const {
+        return (*tiles_[tile_of(cell, tile_cols_)])[offset_of(cell)];
+    }
+    /// @brief Bounds-checked access to a cell.
+    const G& cellAt(Cell cell) const;
+
+    /// @brief Search this snapshot. Supports BFS, Dijkstra and AStar
+    /// (Manhattan or Euclidean); other engines throw std::invalid_argument.
+    Path findPath(Algorithm algorithm, Cell start, Cell dest,
+        const SearchOptions& options = {}) const;
+    /// @brief Budgeted search that reports its status and a best-so-far path.
+    SearchResult search(Algorithm algorithm, Cell start, Cell dest,
+        const SearchOptions& options = {}) const;
+
+    /// @brief Number of tiles.
+    std::size_t tileCount() const { return tiles_.size(); }
+    /// @brief Tiles this snapshot shares with another of the same size.
+    std::size_t sharedTiles(const GenericMazeSnapshot& other) const;
+
+private:
+    friend class GenericMazeEditor<G>;
+    using Tile = std::vector<G>;
+
+    GenericMazeSnapshot(std::size_t width, std::size_t height, std::uint64_t version,
+        std::vector<std::shared_ptr<const Tile>> tiles);
+
+    static std::size_t tile_of(Cell cell, std::size_t tile_cols) {
+        return (cell.row >> kTileShift) * tile_cols + (cell.col >> kTileShift);
+    }
+    static std::size_t offset_of(Cell cell) {
+        return ((cell.row & (kTileSide - 1)) << kTileShift) | (cell.col & (kTileSide - 1));
+    }
+
+    std::size_t width_, height_;
+    std::size_t tile_cols_;
+    std::uint64_t version_;
+    std::vector<std::shared_ptr<const Tile>> tiles_;
+};
+
+/// @brief Writer that derives the next snapshot from a base one.
+///
+/// Reads see the base plus any edits so far. The first write to a tile
+/// copies it; later writes to the same tile go straight to the copy. An
+/// editor belongs to one thread at a time.
+template <GraphCell G>
+class GenericMazeEditor {
+public:
+    using Snapshot = GenericMazeSnapshot<G>;
+
+    /// @brief Start from `base`; nothing is copied until a tile is written.
+    explicit GenericMazeEditor(std::shared_ptr<const Snapshot> base);
+
+    std::size_t getWidth() const { return width_; }
+    std::size_t getHeight() const { return height_; }
+
+    /// @brief Bounds-checked read of the edited state.
+    const G& at(Cell cell) const;
+    /// @brief Bounds-checked write; copies the cell's tile on first touch.
+    void set(Cell cell, const G& value);
+    /// @brief Tiles copied since the last commit.
+    std::size_t copiedTiles() const { return copied_; }
+
+    /// @brief Freeze the edits into a snapshot one version past the base.
+    /// The editor continues from the new snapshot, so its tiles are shared
+    /// again and the next write to any of them copies afresh.
+    std::shared_ptr<const Snapshot> commit();
+
+private:
+    using Tile = typename Snapshot::Tile;
+
+    std::size_t width_, height_;
+    std::size_t tile_cols_;
+    std::uint64_t version_;
+    /// @brief Tiles of the state being built: the base's, or owned copies.
+    std::vector<std::shared_ptr<const Tile>> tiles_;
+    /// @brief Writable copies of touched tiles, null where the base is still shared.
+    std::vector<std::shared_ptr<Tile>> owned_;
+    std::size_t copied_ = 0;
+};
+
+/// @brief Publishes the current snapshot to concurrent readers.
+///
+/// current() is a single atomic load, so a reader never waits on a writer
+/// and keeps its snapshot alive for as long as it holds the pointer.
+/// Writers are serialized among themselves, and publishing is one atomic
+/// store.
+template <GraphCell G>
+class GenericMazeStore {
+public:
+    using Snapshot = GenericMazeSnapshot<G>;
+
+    /// @brief Start with a snapshot of `maze`.
+    explicit GenericMazeStore(const GenericMaze<G>& maze)
+        : current_(std::make_shared<const Snapshot>(maze)) {}
+
+    /// @brief The latest published snapshot.
+    std::shared_ptr<const Snapshot> current() const {
+        return current_.load(std::memory_order_acquire);
+    }
+
+    /// @brief Run `edit(editor)` against the latest snapshot and publish the result.
+    /// @return The snapshot that was published.
+    template <typename Edit>
+    std::shared_ptr<const Snapshot> update(Edit&& edit) {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        GenericMazeEditor<G> editor(current());
+        edit(editor);
+        std::shared_ptr<const Snapshot> next = editor.commit();
+        current_.store(next, std::memory_order_release);
+        return next;
+    }
+
+private:
+    std::atomic<std::shared_ptr<const Snapshot>> current_;
+    std::mutex writer_mutex_;
+};
+
+using MazeSnapshot = GenericMazeSnapshot<CellMetaData>;
+using MazeEditor = GenericMazeEditor<CellMetaData>;
+using MazeStore = GenericMazeStore<CellMetaData>;
+
+#include "snapshot.tpp"
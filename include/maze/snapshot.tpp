@@ -0,0 +1,156 @@
+// snapshot.tpp - Template implementations for maze snapshots and editors
+// Included at the end of snapshot.hpp
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace snapshot_detail {
+
+inline void check_bounds(Cell cell, std::size_t width, std::size_t height) {
+    if (cell.row >= height || cell.col >= width) {
+        throw std::out_of_range("Cell (" + std::to_string(cell.row) + ", "
+            + std::to_string(cell.col) + ") out of bounds for maze of size "
+            + std::to_string(width) + "x" + std::to_string(height));
+    }
+}
+
+}  // namespace snapshot_detail
+
+template <GraphCell G>
+GenericMazeSnapshot<G>::GenericMazeSnapshot(const GenericMaze<G>& maze)
+    : width_(maze.getWidth()),
+      height_(maze.getHeight()),
+      tile_cols_((width_ + kTileSide - 1) >> kTileShift),
+      version_(maze.version()) {
+    const std::size_t tile_rows = (height_ + kTileSide - 1) >> kTileShift;
+    tiles_.reserve(tile_rows * tile_cols_);
+    for (std::size_t tr = 0; tr < tile_rows; ++tr) {
+        for (std::size_t tc = 0; tc < tile_cols_; ++tc) {
+            auto tile = std::make_shared<Tile>(kTileSide * kTileSide);
+            const std::size_t row_end = std::min(height_, (tr + 1) << kTileShift);
+            const std::size_t col_end = std::min(width_, (tc + 1) << kTileShift);
+            for (std::size_t row = tr << kTileShift; row < row_end; ++row) {
+                for (std::size_t col = tc << kTileShift; col < col_end; ++col) {
+                    (*tile)[offset_of({row, col})] = maze.at_unchecked({row, col});
+                }
+            }
+            tiles_.push_back(std::move(tile));
+        }
+    }
+}
+
+template <GraphCell G>
+GenericMazeSnapshot<G>::GenericMazeSnapshot(std::size_t width, std::size_t height,
+    std::uint64_t version, std::vector<std::shared_ptr<const Tile>> tiles)
+    : width_(width),
+      height_(height),
+      tile_cols_((width + kTileSide - 1) >> kTileShift),
+      version_(version),
+      tiles_(std::move(tiles)) {}
+
+template <GraphCell G>
+const G& GenericMazeSnapshot<G>::cellAt(Cell cell) const {
+    snapshot_detail::check_bounds(cell, width_, height_);
+    return at_unchecked(cell);
+}
+
+template <GraphCell G>
+std::size_t GenericMazeSnapshot<G>::sharedTiles(const GenericMazeSnapshot& other) const {
+    if (other.tiles_.size() != tiles_.size()) return 0;
+    std::size_t shared = 0;
+    for (std::size_t i = 0; i < tiles_.size(); ++i) {
+        if (tiles_[i] == other.tiles_[i]) ++shared;
+    }
+    return shared;
+}
+
+template <GraphCell G>
+Path GenericMazeSnapshot<G>::findPath(Algorithm algorithm, Cell start, Cell dest,
+    const SearchOptions& options) const {
+    SearchResult result = search(algorithm, start, dest, options);
+    if (result.status != SearchStatus::Found) return {};
+    return std::move(result.path);
+}
+
+template <GraphCell G>
+SearchResult GenericMazeSnapshot<G>::search(Algorithm algorithm, Cell start, Cell dest,
+    const SearchOptions& options) const {
+    cellAt(start);  // Bounds checks
+    cellAt(dest);
+    if (options.heuristic == Heuristic::Landmarks) {
+        throw std::invalid_argument("Landmark heuristic needs a stored maze");
+    }
+
+    SearchResult result;
+    result.reached = start;
+    if (start == dest) {
+        result.status = SearchStatus::Found;
+        return result;
+    }
+
+    SearchControl control(options, dest);
+    DenseSearchState state(width_, height_);
+    switch (algorithm) {
+        case Algorithm::BFS:
+            result.path = grid_bfs(*this, start, dest, control, state);
+            break;
+        case Algorithm::Dijkstra:
+            result.path = grid_a_star(*this, start, dest, control, state,
+                [](const Cell&, const Cell&) { return 0.0f; });
+            break;
+        case Algorithm::AStar:
+            result.path = grid_a_star(*this, start, dest, control, state,
+                [&](const Cell& from, const Cell& to) {
+                    return options.heuristic == Heuristic::Euclidean
+                        ? euclidean_distance(from, to) : manhattan_distance(from, to);
+                });
+            break;
+        default:
+            throw std::invalid_argument("Snapshots support BFS, Dijkstra and AStar only");
+    }
+
+    for (Direction dir : result.path) result.reached.move(dir);
+    result.expansions = control.expansions();
+    if (result.reached == dest) {
+        result.status = SearchStatus::Found;
+    } else if (control.stopReason()) {
+        result.status = *control.stopReason();
+    }
+    return result;
+}
+
+template <GraphCell G>
+GenericMazeEditor<G>::GenericMazeEditor(std::shared_ptr<const Snapshot> base)
+    : width_(base->width_),
+      height_(base->height_),
+      tile_cols_(base->tile_cols_),
+      version_(base->version_),
+      tiles_(base->tiles_),
+      owned_(tiles_.size()) {}
+
+template <GraphCell G>
+const G& GenericMazeEditor<G>::at(Cell cell) const {
+    snapshot_detail::check_bounds(cell, width_, height_);
+    return (*tiles_[Snapshot::tile_of(cell, tile_cols_)])[Snapshot::offset_of(cell)];
+}
+
+template <GraphCell G>
+void GenericMazeEditor<G>::set(Cell cell, const G& value) {
+    snapshot_detail::check_bounds(cell, width_, height_);
+    const std::size_t tile = Snapshot::tile_of(cell, tile_cols_);
+    if (!owned_[tile]) {
+        owned_[tile] = std::make_shared<Tile>(*tiles_[tile]);
+        tiles_[tile] = owned_[tile];
+        ++copied_;
+    }
+    (*owned_[tile])[Snapshot::offset_of(cell)] = value;
+}
+
+template <GraphCell G>
+std::shared_ptr<const GenericMazeSnapshot<G>> GenericMazeEditor<G>::commit() {
+    // The snapshot now shares the copied tiles, so they must not be written again
+    std::fill(owned_.begin(), owned_.end(), nullptr);
+    copied_ = 0;
+    return std::shared_ptr<const Snapshot>(new Snapshot(width_, height_, ++version_, tiles_));
+}
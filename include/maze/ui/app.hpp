@@ -1,17 +1,19 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <mutex>
 #include <optional>
-#include <random>
 #include <string>
 #include <thread>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/screen_interactive.hpp>
+#include <ftxui/screen/box.hpp>
 
 #include "maze/maze.hpp"
 
@@ -21,7 +23,9 @@ namespace maze::ui {
 class MazeApp {
 public:
     /// @brief Construct the app with the given maze dimensions.
-    MazeApp(std::size_t width, std::size_t height);
+    /// @param seed Seed of the first maze; later mazes derive theirs from it.
+    MazeApp(std::size_t width, std::size_t height,
+        std::optional<std::uint64_t> seed = std::nullopt);
     /// @brief Ensure background worker threads are stopped.
     ~MazeApp();
 
@@ -36,8 +40,22 @@ private:
 
     void regenerate();
     void begin_solve();
+    void begin_race();
     void stop_solver();
     void rebuild_solution_index();
+    /// @brief Drop the current trace, solution and replay position.
+    void clear_replay();
+    /// @brief Steps on the replay timeline: the trace, then the solution reveal.
+    std::size_t replay_length() const;
+    /// @brief Move the replay position on by the wall time since the last
+    /// frame and derive the explored prefix, head and solution pulse from it.
+    void advance_replay();
+    /// @brief Move the replay position to `position`, clamped to the timeline.
+    void seek_replay(double position);
+    /// @brief Whether the replay has expanded `cell` by the current position.
+    bool explored(Cell cell) const {
+        return !expanded_at_.empty() && expanded_at_[cell.row * width_ + cell.col] < explored_steps_;
+    }
 
     bool handle_event(const ftxui::Event& event);
     bool handle_grid_event(const ftxui::Event& event);
@@ -45,6 +63,24 @@ private:
 
     ftxui::Element render_grid();
     ftxui::Element render_sidebar();
+    ftxui::Element render_race();
+    ftxui::Element render_frame_stats();
+    ftxui::Element render_minimap();
+    ftxui::Element render_replay();
+
+    /// @brief Size the viewport to the grid pane and scroll it toward
+    /// whichever of the cursor and the exploration head moved last.
+    void update_viewport();
+    /// @brief Scroll the viewport so `focus` sits inside it, keeping a margin.
+    void scroll_to(Cell focus);
+    /// @brief Side, in cells, of the square block one minimap glyph covers.
+    std::size_t minimap_block() const;
+
+    /// @brief Lock the state shared with the solver thread, tracing the wait.
+    std::unique_lock<std::mutex> lock_state();
+    /// @brief Record how long one frame took to build and when it started.
+    void note_frame(std::chrono::steady_clock::time_point began,
+        std::chrono::steady_clock::time_point ended);
 
     void apply_terrain();
     Cell find_first_passage(bool from_end) const;
@@ -56,7 +92,9 @@ private:
     const std::size_t height_;
 
     Maze maze_;
-    std::mt19937 rng_;
+    /// @brief Seed of the current maze, shown so it can be regenerated.
+    std::uint64_t seed_;
+    bool first_maze_ = true;
 
     const CellMetaData wall_cell_;
     const CellMetaData passage_cell_;
@@ -82,14 +120,59 @@ private:
     Cell dest_{1, 1};
     Cell cursor_{1, 1};
     std::optional<Cell> current_cell_;
-    std::unordered_set<Cell> visited_;
-    std::unordered_set<Cell> frontier_;
     std::unordered_map<Cell, std::size_t> solution_index_;
     std::vector<Cell> solution_cells_;
+    std::vector<RaceEntry> race_entries_;
+    std::chrono::steady_clock::time_point race_started_;
     std::size_t pulse_index_ = 0;
     bool show_solution_ = false;
     bool focus_on_grid_ = true;
 
+    /// @brief Timeline steps per second at 1x; one step per 12 ms.
+    static constexpr double kReplayRate = 1000.0 / 12.0;
+    static constexpr double kMinReplaySpeed = 0.25;
+    static constexpr double kMaxReplaySpeed = 65536.0;
+    /// @brief Redraw interval while a replay or race is running.
+    static constexpr std::chrono::milliseconds kFrameInterval{16};
+    /// @brief Cells the last solve expanded, in order.
+    ExplorationTrace trace_;
+    /// @brief Trace step that first expanded each cell (row-major), or
+    /// UINT32_MAX if it never was; a frame tests cells against it in O(1).
+    std::vector<std::uint32_t> expanded_at_;
+    /// @brief Trace steps shown as explored at the current position.
+    std::size_t explored_steps_ = 0;
+    double replay_position_ = 0.0;
+    double replay_speed_ = 1.0;
+    bool replay_paused_ = false;
+    std::chrono::steady_clock::time_point replay_tick_;
+    /// @brief Set while the replay is advancing, so the ticker keeps redrawing.
+    std::atomic<bool> replay_running_{false};
+
+    /// @brief Cells kept between a followed cell and the viewport edge.
+    static constexpr std::size_t kViewMargin = 3;
+    static constexpr std::size_t kMinimapCols = 24;
+    static constexpr std::size_t kMinimapRows = 12;
+    /// @brief Cells sampled along each side of a minimap block.
+    static constexpr std::size_t kMinimapSamples = 4;
+    /// @brief Grid pane from the last layout; the viewport is sized to fit it.
+    ftxui::Box grid_box_;
+    Cell view_origin_{0, 0};
+    std::size_t view_rows_ = 0;
+    std::size_t view_cols_ = 0;
+    Cell followed_cursor_{1, 1};
+    std::optional<Cell> followed_current_;
+    /// @brief Solution cells per minimap block, rebuilt with the solution index.
+    std::vector<std::uint32_t> solution_blocks_;
+    bool show_minimap_ = true;
+
+    /// @brief Frames averaged by the frame-time readout.
+    static constexpr std::size_t kFrameWindow = 64;
+    bool show_frame_stats_ = false;
+    std::array<double, kFrameWindow> frame_ms_{};
+    std::array<double, kFrameWindow> frame_gap_ms_{};
+    std::size_t frames_ = 0;
+    std::chrono::steady_clock::time_point last_frame_;
+
     ftxui::Component algorithm_menu_;
     ftxui::Component generator_menu_;
     ftxui::Component terrain_menu_;
@@ -0,0 +1,318 @@
+#include "maze/corpus.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "maze/core/parallel.hpp"
+
+namespace {
+
+constexpr std::array<char, 4> kMagic{'M', 'Z', 'C', 'P'};
+constexpr std::uint64_t kVersion = 1;
+/// @brief Magic, version, maze count and index offset.
+constexpr std::uint64_t kHeaderBytes = kMagic.size() + 3 * 8;
+/// @brief Offset, length, width, height, seed and fingerprint.
+constexpr std::uint64_t kEntryBytes = 6 * 8;
+/// @brief Wall flag, glyph, color and weight bits.
+constexpr std::uint64_t kPaletteEntryBytes = 3 + 4;
+constexpr std::size_t kMaxPalette = 256;
+
+void put_u64(std::string& out, std::uint64_t value) {
+    for (std::size_t i = 0; i < 8; ++i) out += static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+std::uint64_t get_u64(const char*& in, const char* end) {
+    if (end - in < 8) throw std::runtime_error("Truncated corpus");
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < 8; ++i) {
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(*in++)) << (8 * i);
+    }
+    return value;
+}
+
+bool same_cell(const CellMetaData& a, const CellMetaData& b) {
+    return a.wall == b.wall && a.glyph == b.glyph && a.color == b.color
+        && std::bit_cast<std::uint32_t>(a.weight) == std::bit_cast<std::uint32_t>(b.weight);
+}
+
+// Every cell kind a job can produce, without repeats
+std::vector<CellMetaData> palette_of(const CorpusJob& job) {
+    std::vector<CellMetaData> palette;
+    auto add = [&](const CellMetaData& cell) {
+        if (std::none_of(palette.begin(), palette.end(),
+                [&](const CellMetaData& known) { return same_cell(known, cell); })) {
+            palette.push_back(cell);
+        }
+    };
+    if (job.random_cells.empty()) {
+        add(job.wall);
+        add(job.passage);
+    }
+    for (const CellMetaData& cell : job.random_cells) add(cell);
+    for (const CellMetaData& cell : job.terrain) add(cell);
+    return palette;
+}
+
+std::size_t bits_per_cell(std::size_t palette_size) {
+    return std::max<std::size_t>(1, std::bit_width(palette_size - 1));
+}
+
+std::uint64_t record_bytes(std::size_t width, std::size_t height, std::size_t palette_size) {
+    const std::uint64_t bits = static_cast<std::uint64_t>(width) * height
+        * bits_per_cell(palette_size);
+    return 3 * 8 + palette_size * kPaletteEntryBytes + (bits + 7) / 8;
+}
+
+void run_job(const CorpusJob& job, Maze& maze) {
+    if (job.random_cells.empty()) {
+        maze.generate(job.algorithm, job.wall, job.passage, job.seed);
+    } else {
+        // Jobs already run in parallel, so each fill stays on its worker
+        std::vector<CellMetaData> pool = job.random_cells;
+        maze.generateRandom(pool, job.wall_density, job.seed, 1);
+    }
+    if (!job.terrain.empty()) maze.paintTerrain(job.terrain, job.seed, 1);
+}
+
+// Size fields, palette, then each cell's palette index packed LSB first
+void encode(const Maze& maze, const std::vector<CellMetaData>& palette, std::string& out) {
+    out.clear();
+    put_u64(out, maze.getWidth());
+    put_u64(out, maze.getHeight());
+    put_u64(out, palette.size());
+    for (const CellMetaData& cell : palette) {
+        out += static_cast<char>(cell.wall ? 1 : 0);
+        out += cell.glyph;
+        out += static_cast<char>(static_cast<std::uint8_t>(cell.color));
+        const auto weight = std::bit_cast<std::uint32_t>(cell.weight);
+        for (std::size_t i = 0; i < 4; ++i) out += static_cast<char>((weight >> (8 * i)) & 0xFF);
+    }
+
+    const std::size_t bits = bits_per_cell(palette.size());
+    std::uint64_t pending = 0;
+    std::size_t pending_bits = 0;
+    std::size_t last = 0;  // Neighbouring cells are usually the same kind
+    for (std::size_t row = 0; row < maze.getHeight(); ++row) {
+        for (std::size_t col = 0; col < maze.getWidth(); ++col) {
+            const CellMetaData& cell = maze.at_unchecked(Cell{row, col});
+            if (!same_cell(palette[last], cell)) {
+                auto it = std::find_if(palette.begin(), palette.end(),
+                    [&](const CellMetaData& known) { return same_cell(known, cell); });
+                if (it == palette.end()) throw std::logic_error("Generated cell missing from palette");
+                last = static_cast<std::size_t>(it - palette.begin());
+            }
+            pending |= static_cast<std::uint64_t>(last) << pending_bits;
+            pending_bits += bits;
+            while (pending_bits >= 8) {
+                out += static_cast<char>(pending & 0xFF);
+                pending >>= 8;
+                pending_bits -= 8;
+            }
+        }
+    }
+    if (pending_bits > 0) out += static_cast<char>(pending & 0xFF);
+}
+
+}  // namespace
+
+std::vector<CorpusEntry> buildCorpus(const std::string& path,
+    const std::vector<CorpusJob>& jobs, std::size_t threads) {
+    // Lay out every record before generating anything
+    std::vector<CorpusEntry> entries(jobs.size());
+    std::vector<std::vector<CellMetaData>> palettes(jobs.size());
+    std::uint64_t offset = kHeaderBytes;
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        const CorpusJob& job = jobs[i];
+        if (job.width == 0 || job.height == 0) {
+            throw std::invalid_argument("Corpus job " + std::to_string(i) + " has no cells");
+        }
+        palettes[i] = palette_of(job);
+        if (palettes[i].size() > kMaxPalette) {
+            throw std::invalid_argument("Corpus job " + std::to_string(i)
+                + " has more than 256 kinds of cell");
+        }
+        entries[i] = {offset, record_bytes(job.width, job.height, palettes[i].size()),
+            job.width, job.height, job.seed, 0};
+        offset += entries[i].bytes;
+    }
+    const std::uint64_t index_offset = offset;
+
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        std::string header(kMagic.data(), kMagic.size());
+        put_u64(header, kVersion);
+        put_u64(header, jobs.size());
+        put_u64(header, index_offset);
+        out.write(header.data(), static_cast<std::streamsize>(header.size()));
+        // Size the file up front so workers only ever overwrite
+        const std::uint64_t file_bytes = index_offset + jobs.size() * kEntryBytes;
+        if (file_bytes > kHeaderBytes) {
+            out.seekp(static_cast<std::streamoff>(file_bytes - 1));
+            out.put('\0');
+        }
+        if (!out) throw std::runtime_error("Failed to create corpus " + path);
+    }
+
+    // Equal sizes run back to back, so workers can keep their grids
+    std::vector<std::size_t> order(jobs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return std::pair(jobs[a].height, jobs[a].width) < std::pair(jobs[b].height, jobs[b].width);
+    });
+
+    std::atomic<std::size_t> next{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    const std::size_t workers = std::max<std::size_t>(1, std::min(resolve_threads(threads), jobs.size()));
+    run_team(workers, [&](std::size_t) {
+        MAZE_TRACE_SCOPE("corpus", "Corpus worker");
+        try {
+            std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+            std::optional<Maze> maze;
+            std::string record;
+            for (std::size_t i = next++; i < order.size(); i = next++) {
+                const std::size_t job_index = order[i];
+                const CorpusJob& job = jobs[job_index];
+                if (!maze || maze->getWidth() != job.width || maze->getHeight() != job.height) {
+                    maze.emplace(job.width, job.height);
+                }
+                run_job(job, *maze);
+                encode(*maze, palettes[job_index], record);
+                entries[job_index].fingerprint = maze->fingerprint();
+                out.seekp(static_cast<std::streamoff>(entries[job_index].offset));
+                out.write(record.data(), static_cast<std::streamsize>(record.size()));
+            }
+            out.flush();
+            if (!out) throw std::runtime_error("Failed to write corpus " + path);
+        } catch (...) {
+            // Stop handing out jobs; the first failure is reported
+            next = order.size();
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+        }
+    });
+    if (error) std::rethrow_exception(error);
+
+    std::string index;
+    index.reserve(entries.size() * kEntryBytes);
+    for (const CorpusEntry& entry : entries) {
+        put_u64(index, entry.offset);
+        put_u64(index, entry.bytes);
+        put_u64(index, entry.width);
+        put_u64(index, entry.height);
+        put_u64(index, entry.seed);
+        put_u64(index, entry.fingerprint);
+    }
+    std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+    out.seekp(static_cast<std::streamoff>(index_offset));
+    out.write(index.data(), static_cast<std::streamsize>(index.size()));
+    out.flush();
+    if (!out) throw std::runtime_error("Failed to write corpus index " + path);
+    return entries;
+}
+
+CorpusReader::CorpusReader(std::string path) : path_(std::move(path)) {
+    std::ifstream in(path_, std::ios::binary);
+    std::string header(kHeaderBytes, '\0');
+    if (!in.read(header.data(), static_cast<std::streamsize>(header.size()))
+        || !std::equal(kMagic.begin(), kMagic.end(), header.begin())) {
+        throw std::runtime_error("Not a maze corpus: " + path_);
+    }
+    const char* cursor = header.data() + kMagic.size();
+    const char* end = header.data() + header.size();
+    if (get_u64(cursor, end) != kVersion) {
+        throw std::runtime_error("Unsupported maze corpus version");
+    }
+    const std::uint64_t count = get_u64(cursor, end);
+    const std::uint64_t index_offset = get_u64(cursor, end);
+
+    std::string index(count * kEntryBytes, '\0');
+    in.seekg(static_cast<std::streamoff>(index_offset));
+    if (!in.read(index.data(), static_cast<std::streamsize>(index.size()))) {
+        throw std::runtime_error("Truncated corpus index");
+    }
+    cursor = index.data();
+    end = index.data() + index.size();
+    entries_.reserve(count);
+    for (std::uint64_t i = 0; i < count; ++i) {
+        CorpusEntry entry;
+        entry.offset = get_u64(cursor, end);
+        entry.bytes = get_u64(cursor, end);
+        entry.width = get_u64(cursor, end);
+        entry.height = get_u64(cursor, end);
+        entry.seed = get_u64(cursor, end);
+        entry.fingerprint = get_u64(cursor, end);
+        if (entry.offset < kHeaderBytes || entry.offset + entry.bytes > index_offset) {
+            throw std::runtime_error("Corpus entry " + std::to_string(i) + " out of bounds");
+        }
+        entries_.push_back(entry);
+    }
+}
+
+Maze CorpusReader::load(std::size_t index) const {
+    if (index >= entries_.size()) {
+        throw std::out_of_range("Maze " + std::to_string(index)
+            + " out of range for a corpus of " + std::to_string(entries_.size()));
+    }
+    const CorpusEntry& entry = entries_[index];
+    std::ifstream in(path_, std::ios::binary);
+    std::string record(entry.bytes, '\0');
+    in.seekg(static_cast<std::streamoff>(entry.offset));
+    if (!in.read(record.data(), static_cast<std::streamsize>(record.size()))) {
+        throw std::runtime_error("Truncated corpus record");
+    }
+
+    const char* cursor = record.data();
+    const char* end = record.data() + record.size();
+    const std::size_t width = get_u64(cursor, end);
+    const std::size_t height = get_u64(cursor, end);
+    const std::size_t palette_size = get_u64(cursor, end);
+    if (width != entry.width || height != entry.height
+        || palette_size == 0 || palette_size > kMaxPalette
+        || record_bytes(width, height, palette_size) != entry.bytes) {
+        throw std::runtime_error("Corrupt corpus record");
+    }
+
+    std::vector<CellMetaData> palette(palette_size);
+    for (CellMetaData& cell : palette) {
+        cell.wall = cursor[0] != 0;
+        cell.glyph = cursor[1];
+        cell.color = static_cast<Color>(static_cast<unsigned char>(cursor[2]));
+        std::uint32_t weight = 0;
+        for (std::size_t i = 0; i < 4; ++i) {
+            weight |= static_cast<std::uint32_t>(static_cast<unsigned char>(cursor[3 + i])) << (8 * i);
+        }
+        cell.weight = std::bit_cast<float>(weight);
+        cursor += kPaletteEntryBytes;
+    }
+
+    Maze maze(width, height);
+    const std::size_t bits = bits_per_cell(palette_size);
+    const std::uint64_t mask = (std::uint64_t{1} << bits) - 1;
+    std::uint64_t pending = 0;
+    std::size_t pending_bits = 0;
+    for (std::size_t row = 0; row < height; ++row) {
+        for (std::size_t col = 0; col < width; ++col) {
+            while (pending_bits < bits) {
+                pending |= static_cast<std::uint64_t>(static_cast<unsigned char>(*cursor++)) << pending_bits;
+                pending_bits += 8;
+            }
+            const std::size_t kind = pending & mask;
+            pending >>= bits;
+            pending_bits -= bits;
+            if (kind >= palette_size) throw std::runtime_error("Corrupt corpus record");
+            maze.at_unchecked(Cell{row, col}) = palette[kind];
+        }
+    }
+    return maze;
+}
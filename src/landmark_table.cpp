@@ -0,0 +1,133 @@
+#include "maze/index/landmark_table.hpp"
+
+#include <array>
+#include <bit>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::array<char, 4> kMagic{'M', 'Z', 'L', 'T'};
+constexpr std::uint32_t kVersion = 1;
+
+void write_u64(std::ostream& os, std::uint64_t value) {
+    std::array<char, 8> bytes;
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+    os.write(bytes.data(), bytes.size());
+}
+
+std::uint64_t read_u64(std::istream& is) {
+    std::array<unsigned char, 8> bytes{};
+    if (!is.read(reinterpret_cast<char*>(bytes.data()), bytes.size())) {
+        throw std::runtime_error("Truncated landmark table");
+    }
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        value |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+// Bytes left in a seekable stream; nullopt for pipes and other unseekable input
+std::optional<std::uint64_t> remaining_bytes(std::istream& is) {
+    const std::istream::pos_type here = is.tellg();
+    if (here == std::istream::pos_type(-1)) return std::nullopt;
+    is.seekg(0, std::ios::end);
+    const std::istream::pos_type end = is.tellg();
+    is.seekg(here);
+    if (end == std::istream::pos_type(-1) || !is) {
+        is.clear();
+        is.seekg(here);
+        return std::nullopt;
+    }
+    return static_cast<std::uint64_t>(end - here);
+}
+
+// a * b, throwing instead of wrapping so a forged header cannot shrink a size check
+std::uint64_t checked_product(std::uint64_t a, std::uint64_t b) {
+    if (a != 0 && b > std::numeric_limits<std::uint64_t>::max() / a) {
+        throw std::runtime_error("Landmark table too large");
+    }
+    return a * b;
+}
+
+}  // namespace
+
+void LandmarkTable::save(std::ostream& os) const {
+    os.write(kMagic.data(), kMagic.size());
+    write_u64(os, kVersion);
+    write_u64(os, width);
+    write_u64(os, height);
+    write_u64(os, fingerprint);
+    write_u64(os, landmarks.size());
+    for (const Cell& cell : landmarks) {
+        write_u64(os, cell.row);
+        write_u64(os, cell.col);
+    }
+    for (float d : distances) {
+        std::array<char, 4> bytes;
+        auto bits = std::bit_cast<std::uint32_t>(d);
+        for (std::size_t i = 0; i < bytes.size(); ++i) {
+            bytes[i] = static_cast<char>((bits >> (8 * i)) & 0xFF);
+        }
+        os.write(bytes.data(), bytes.size());
+    }
+    if (!os) throw std::runtime_error("Failed to write landmark table");
+}
+
+LandmarkTable LandmarkTable::load(std::istream& is) {
+    std::array<char, 4> magic{};
+    if (!is.read(magic.data(), magic.size()) || magic != kMagic) {
+        throw std::runtime_error("Not a landmark table");
+    }
+    if (read_u64(is) != kVersion) {
+        throw std::runtime_error("Unsupported landmark table version");
+    }
+
+    LandmarkTable table;
+    table.width = read_u64(is);
+    table.height = read_u64(is);
+    table.fingerprint = read_u64(is);
+    std::uint64_t count = read_u64(is);
+
+    // The header is untrusted: size everything it claims against the bytes that
+    // are really there before allocating
+    const std::uint64_t values = checked_product(count, checked_product(table.width, table.height));
+    const std::uint64_t cells_bytes = checked_product(count, 16);
+    const std::uint64_t distance_bytes = checked_product(values, 4);
+    if (distance_bytes > std::numeric_limits<std::uint64_t>::max() - cells_bytes) {
+        throw std::runtime_error("Landmark table too large");
+    }
+    const std::uint64_t bytes = cells_bytes + distance_bytes;
+    const std::optional<std::uint64_t> available = remaining_bytes(is);
+    if (available && bytes > *available) {
+        throw std::runtime_error("Truncated landmark table");
+    }
+    if (available) table.landmarks.reserve(count);
+    for (std::uint64_t i = 0; i < count; ++i) {
+        std::size_t row = read_u64(is);
+        std::size_t col = read_u64(is);
+        if (row >= table.height || col >= table.width) {
+            throw std::runtime_error("Landmark out of bounds");
+        }
+        table.landmarks.push_back({row, col});
+    }
+
+    // Unseekable input cannot be measured, so it grows only as bytes arrive
+    if (available) table.distances.reserve(values);
+    for (std::uint64_t i = 0; i < values; ++i) {
+        std::array<unsigned char, 4> raw{};
+        if (!is.read(reinterpret_cast<char*>(raw.data()), raw.size())) {
+            throw std::runtime_error("Truncated landmark table");
+        }
+        std::uint32_t bits = 0;
+        for (std::size_t b = 0; b < raw.size(); ++b) {
+            bits |= static_cast<std::uint32_t>(raw[b]) << (8 * b);
+        }
+        table.distances.push_back(std::bit_cast<float>(bits));
+    }
+    return table;
+}
@@ -1,7 +1,83 @@
 #include "maze/ui/app.hpp"
 
-int main() {
-    maze::ui::MazeApp app(31, 31);
-    app.run();
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+// Parse "N" (square) or "WxH" into width and height; nullopt if malformed
+std::optional<std::pair<std::size_t, std::size_t>> parse_size(const std::string& text) {
+    // stoull would accept signs and leading spaces, so require digits up front
+    auto digits_at = [&text](std::size_t i) {
+        return i < text.size() && text[i] >= '0' && text[i] <= '9';
+    };
+    if (!digits_at(0)) return std::nullopt;
+    try {
+        std::size_t used = 0;
+        std::size_t width = std::stoull(text, &used);
+        std::size_t height = width;
+        if (used < text.size()) {
+            if (text[used] != 'x' || !digits_at(used + 1)) return std::nullopt;
+            std::string rest = text.substr(used + 1);
+            height = std::stoull(rest, &used);
+            if (used < rest.size()) return std::nullopt;
+        }
+        if (width < 3 || height < 3) return std::nullopt;
+        return std::pair{width, height};
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::optional<std::uint64_t> seed;
+    std::optional<std::string> trace_path;
+    std::pair<std::size_t, std::size_t> size{31, 31};
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc) {
+            try {
+                seed = std::stoull(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << "Invalid seed: " << argv[i] << '\n';
+                return 1;
+            }
+        } else if (arg == "--size" && i + 1 < argc) {
+            auto parsed = parse_size(argv[++i]);
+            if (!parsed) {
+                std::cerr << "Invalid size (N or WxH, at least 3): " << argv[i] << '\n';
+                return 1;
+            }
+            size = *parsed;
+        } else if (arg == "--trace" && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--seed N] [--size N|WxH] [--trace FILE]\n";
+            return 1;
+        }
+    }
+
+    if (trace_path) Tracer::instance().enable();
+    {
+        maze::ui::MazeApp app(size.first, size.second, seed);
+        app.run();
+    }
+
+    if (trace_path) {
+        std::ofstream out(*trace_path);
+        if (!out) {
+            std::cerr << "Cannot write trace: " << *trace_path << '\n';
+            return 1;
+        }
+        Tracer::instance().writeChromeTrace(out);
+    }
     return 0;
 }
@@ -0,0 +1,119 @@
+#include "maze/server/query_server.hpp"
+
+#include <atomic>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+std::atomic<bool> g_stop{false};
+
+void request_stop(int) { g_stop = true; }
+
+std::optional<GenerationAlgorithm> parse_generator(const std::string& name) {
+    if (name == "backtracker") return GenerationAlgorithm::RecursiveBacktracker;
+    if (name == "prim") return GenerationAlgorithm::Prim;
+    if (name == "kruskal") return GenerationAlgorithm::Kruskal;
+    return std::nullopt;
+}
+
+int usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--size N|WxH] [--seed N]"
+        " [--generator backtracker|prim|kruskal] [--workers N] [--cache N]"
+        " [--landmarks N | --landmark-file FILE] [--socket PATH]\n";
+    return 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t width = 1001, height = 1001;
+    std::uint64_t seed = 1;
+    GenerationAlgorithm generator = GenerationAlgorithm::RecursiveBacktracker;
+    std::size_t workers = 0, cache = 4096, landmarks = 0;
+    std::optional<std::string> landmark_file, socket_path;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) return usage(argv[0]);
+            std::string value = argv[++i];
+            if (arg == "--size") {
+                std::size_t used = 0;
+                width = height = std::stoull(value, &used);
+                if (used < value.size()) {
+                    if (value[used] != 'x') return usage(argv[0]);
+                    height = std::stoull(value.substr(used + 1));
+                }
+            } else if (arg == "--seed") {
+                seed = std::stoull(value);
+            } else if (arg == "--generator") {
+                auto parsed = parse_generator(value);
+                if (!parsed) return usage(argv[0]);
+                generator = *parsed;
+            } else if (arg == "--workers") {
+                workers = std::stoull(value);
+            } else if (arg == "--cache") {
+                cache = std::stoull(value);
+            } else if (arg == "--landmarks") {
+                landmarks = std::stoull(value);
+            } else if (arg == "--landmark-file") {
+                landmark_file = value;
+            } else if (arg == "--socket") {
+                socket_path = value;
+            } else {
+                return usage(argv[0]);
+            }
+        }
+    } catch (const std::exception&) {
+        return usage(argv[0]);
+    }
+
+    // Build once and keep every index warm for the life of the process
+    const CellMetaData wall{true, '#', Color::gray, 1.0f};
+    const CellMetaData passage{false, ' ', Color::white, 1.0f};
+    std::unique_ptr<Maze> maze;
+    try {
+        maze = std::make_unique<Maze>(width, height);
+        maze->generate(generator, wall, passage, seed);
+        maze->trackComponents();
+        maze->connected({0, 0}, {0, 0});  // Builds the labels now, not on the first query
+        maze->cachePaths(cache);
+        if (landmark_file) {
+            std::ifstream in(*landmark_file, std::ios::binary);
+            if (!in) throw std::runtime_error("Cannot read " + *landmark_file);
+            maze->setLandmarks(std::make_shared<const LandmarkTable>(LandmarkTable::load(in)));
+        } else if (landmarks > 0) {
+            maze->buildLandmarks(landmarks);
+        }
+    } catch (const std::exception& error) {
+        std::cerr << "Cannot prepare maze: " << error.what() << '\n';
+        return 1;
+    }
+    std::cerr << "Ready: " << width << "x" << height << " maze, seed " << seed << '\n';
+
+    maze::server::QueryServer server(*maze, workers);
+    if (socket_path) {
+        std::signal(SIGINT, request_stop);
+        std::signal(SIGTERM, request_stop);
+        try {
+            server.serveSocket(*socket_path, g_stop);
+        } catch (const std::exception& error) {
+            std::cerr << error.what() << '\n';
+            return 1;
+        }
+    } else {
+        std::ios::sync_with_stdio(false);
+        server.serve(std::cin, std::cout);
+    }
+
+    std::cerr << "Latency: " << server.statsJson() << '\n';
+    return 0;
+}
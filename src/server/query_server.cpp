@@ -0,0 +1,604 @@
+#include "maze/server/query_server.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace maze::server {
+
+namespace {
+
+// Just enough JSON for flat request objects: numbers, strings, booleans,
+// null, arrays and nested objects. Malformed or too deeply nested input
+// throws std::invalid_argument.
+struct JsonValue {
+    using Array = std::vector<JsonValue>;
+    using Object = std::map<std::string, JsonValue, std::less<>>;
+    std::variant<std::nullptr_t, bool, double, std::string, Array, Object> value;
+    /// @brief Source text, so ids are echoed back exactly as sent.
+    std::string_view raw;
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(std::string_view text) : text_(text) {}
+
+    JsonValue parseDocument() {
+        JsonValue value = parse_value();
+        skip_space();
+        if (pos_ != text_.size()) fail("trailing characters");
+        return value;
+    }
+
+private:
+    /// @brief Requests are flat, so anything deeper is an attack, not a query.
+    static constexpr std::size_t kMaxDepth = 16;
+
+    std::string_view text_;
+    std::size_t pos_ = 0;
+    std::size_t depth_ = 0;
+
+    [[noreturn]] void fail(const char* what) const {
+        throw std::invalid_argument(std::string("Malformed JSON: ") + what);
+    }
+    void skip_space() {
+        while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\t'
+            || text_[pos_] == '\r' || text_[pos_] == '\n')) ++pos_;
+    }
+    bool consume(char c) {
+        skip_space();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+    void expect(char c) {
+        if (!consume(c)) fail("unexpected character");
+    }
+    bool consume_word(std::string_view word) {
+        if (text_.substr(pos_, word.size()) != word) return false;
+        pos_ += word.size();
+        return true;
+    }
+
+    JsonValue parse_value() {
+        skip_space();
+        if (pos_ >= text_.size()) fail("unexpected end");
+        const std::size_t begin = pos_;
+        JsonValue result;
+        const char c = text_[pos_];
+        if (c == '{' || c == '[') {
+            // Containers recurse, so untrusted input must not nest without bound
+            if (++depth_ > kMaxDepth) fail("nesting too deep");
+            if (c == '{') {
+                result.value = parse_object();
+            } else {
+                result.value = parse_array();
+            }
+            --depth_;
+        } else if (c == '"') {
+            result.value = parse_string();
+        } else if (consume_word("true")) {
+            result.value = true;
+        } else if (consume_word("false")) {
+            result.value = false;
+        } else if (consume_word("null")) {
+            result.value = nullptr;
+        } else {
+            result.value = parse_number();
+        }
+        result.raw = text_.substr(begin, pos_ - begin);
+        return result;
+    }
+
+    JsonValue::Object parse_object() {
+        expect('{');
+        JsonValue::Object object;
+        if (consume('}')) return object;
+        do {
+            skip_space();
+            if (pos_ >= text_.size() || text_[pos_] != '"') fail("expected a key");
+            std::string key = parse_string();
+            expect(':');
+            object.insert_or_assign(std::move(key), parse_value());
+        } while (consume(','));
+        expect('}');
+        return object;
+    }
+
+    JsonValue::Array parse_array() {
+        expect('[');
+        JsonValue::Array array;
+        if (consume(']')) return array;
+        do {
+            array.push_back(parse_value());
+        } while (consume(','));
+        expect(']');
+        return array;
+    }
+
+    std::string parse_string() {
+        ++pos_;  // Opening quote
+        std::string out;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char c = text_[pos_++];
+            if (c != '\\') {
+                out.push_back(c);
+                continue;
+            }
+            if (pos_ >= text_.size()) break;
+            switch (char escaped = text_[pos_++]) {
+                case 'n': out.push_back('\n'); break;
+                case 't': out.push_back('\t'); break;
+                case 'r': out.push_back('\r'); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'u':
+                    // Request fields are ASCII; keep other code points as '?'
+                    if (pos_ + 4 > text_.size()) fail("short escape");
+                    pos_ += 4;
+                    out.push_back('?');
+                    break;
+                default: out.push_back(escaped); break;
+            }
+        }
+        if (pos_ >= text_.size()) fail("unterminated string");
+        ++pos_;  // Closing quote
+        return out;
+    }
+
+    double parse_number() {
+        const char* first = text_.data() + pos_;
+        double number = 0.0;
+        auto [end, error] = std::from_chars(first, text_.data() + text_.size(), number);
+        if (error != std::errc() || end == first) fail("expected a value");
+        pos_ += static_cast<std::size_t>(end - first);
+        return number;
+    }
+};
+
+void append_escaped(std::string& out, std::string_view text) {
+    out.push_back('"');
+    for (char c : text) {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        if (static_cast<unsigned char>(c) >= 0x20) out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+// Integral, non-negative and exactly representable, so the cast is safe
+bool is_count(double number) {
+    return number >= 0 && number <= 9007199254740992.0 && number == std::floor(number);
+}
+
+// Typed field access for one request; errors name the offending field
+class Request {
+public:
+    explicit Request(const JsonValue& root) {
+        object_ = std::get_if<JsonValue::Object>(&root.value);
+        if (!object_) throw std::invalid_argument("Request must be a JSON object");
+    }
+
+    const JsonValue* find(std::string_view key) const {
+        auto it = object_->find(key);
+        return it == object_->end() ? nullptr : &it->second;
+    }
+
+    std::string text(std::string_view key, std::string fallback) const {
+        const JsonValue* value = find(key);
+        if (!value) return fallback;
+        if (auto* s = std::get_if<std::string>(&value->value)) return *s;
+        throw std::invalid_argument(std::string(key) + " must be a string");
+    }
+
+    std::size_t count(std::string_view key, std::size_t fallback) const {
+        const JsonValue* value = find(key);
+        if (!value) return fallback;
+        auto* number = std::get_if<double>(&value->value);
+        if (!number || !is_count(*number)) {
+            throw std::invalid_argument(std::string(key) + " must be a non-negative integer");
+        }
+        return static_cast<std::size_t>(*number);
+    }
+
+    bool flag(std::string_view key, bool fallback) const {
+        const JsonValue* value = find(key);
+        if (!value) return fallback;
+        if (auto* b = std::get_if<bool>(&value->value)) return *b;
+        throw std::invalid_argument(std::string(key) + " must be true or false");
+    }
+
+    Cell cell(std::string_view key, const Maze& maze) const {
+        const JsonValue* value = find(key);
+        auto* pair = value ? std::get_if<JsonValue::Array>(&value->value) : nullptr;
+        if (!pair || pair->size() != 2) {
+            throw std::invalid_argument(std::string(key) + " must be [row, col]");
+        }
+        std::size_t coords[2];
+        for (std::size_t i = 0; i < 2; ++i) {
+            auto* number = std::get_if<double>(&(*pair)[i].value);
+            if (!number || !is_count(*number)) {
+                throw std::invalid_argument(std::string(key) + " must be [row, col]");
+            }
+            coords[i] = static_cast<std::size_t>(*number);
+        }
+        if (coords[0] >= maze.getHeight() || coords[1] >= maze.getWidth()) {
+            throw std::out_of_range(std::string(key) + " is outside the maze");
+        }
+        return {coords[0], coords[1]};
+    }
+
+private:
+    const JsonValue::Object* object_;
+};
+
+Algorithm parse_algorithm(const std::string& name) {
+    static const std::map<std::string, Algorithm, std::less<>> kNames{
+        {"bfs", Algorithm::BFS}, {"dfs", Algorithm::DFS},
+        {"dijkstra", Algorithm::Dijkstra}, {"astar", Algorithm::AStar},
+        {"greedy", Algorithm::GreedyBestFirst}, {"arastar", Algorithm::ARAStar},
+        {"delta", Algorithm::DeltaStepping}, {"parallel-bfs", Algorithm::ParallelBFS}};
+    auto it = kNames.find(name);
+    if (it == kNames.end()) throw std::invalid_argument("Unknown algorithm: " + name);
+    return it->second;
+}
+
+Heuristic parse_heuristic(const std::string& name) {
+    if (name == "manhattan") return Heuristic::Manhattan;
+    if (name == "euclidean") return Heuristic::Euclidean;
+    if (name == "landmarks") return Heuristic::Landmarks;
+    throw std::invalid_argument("Unknown heuristic: " + name);
+}
+
+const char* status_name(SearchStatus status) {
+    switch (status) {
+        case SearchStatus::Found: return "found";
+        case SearchStatus::NoPath: return "no_path";
+        case SearchStatus::ExpansionLimit: return "expansion_limit";
+        case SearchStatus::DeadlineExpired: return "deadline";
+        case SearchStatus::Cancelled: return "cancelled";
+    }
+    return "no_path";
+}
+
+constexpr std::array<const char*, 5> kOpNames{"path", "connected", "info", "stats", "invalid"};
+
+}  // namespace
+
+void LatencyHistogram::record(std::uint64_t micros) {
+    const std::size_t bucket = std::min<std::size_t>(std::bit_width(micros), kBuckets - 1);
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    std::uint64_t seen = max_.load(std::memory_order_relaxed);
+    while (micros > seen && !max_.compare_exchange_weak(seen, micros, std::memory_order_relaxed)) {}
+}
+
+std::uint64_t LatencyHistogram::percentile(double q) const {
+    const std::uint64_t total = count();
+    if (total == 0) return 0;
+    const auto rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(total)));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= std::max<std::uint64_t>(rank, 1)) {
+            return std::min(std::uint64_t{1} << i, max());
+        }
+    }
+    return max();
+}
+
+void LatencyHistogram::writeJson(std::string& out) const {
+    out += "{\"count\":" + std::to_string(count())
+        + ",\"p50_us\":" + std::to_string(percentile(0.50))
+        + ",\"p90_us\":" + std::to_string(percentile(0.90))
+        + ",\"p99_us\":" + std::to_string(percentile(0.99))
+        + ",\"max_us\":" + std::to_string(max())
+        + ",\"buckets\":[";
+    // Trailing empty buckets carry no information
+    std::size_t last = kBuckets;
+    while (last > 0 && buckets_[last - 1].load(std::memory_order_relaxed) == 0) --last;
+    for (std::size_t i = 0; i < last; ++i) {
+        if (i > 0) out.push_back(',');
+        out += std::to_string(buckets_[i].load(std::memory_order_relaxed));
+    }
+    out += "]}";
+}
+
+QueryServer::QueryServer(Maze& maze, std::size_t workers)
+    : maze_(maze), worker_count_(resolve_threads(workers)) {
+    workers_.reserve(worker_count_);
+    for (std::size_t i = 0; i < worker_count_; ++i) {
+        workers_.emplace_back([this] { worker_loop(); });
+    }
+}
+
+QueryServer::~QueryServer() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        stopping_ = true;
+    }
+    queue_ready_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}
+
+std::string QueryServer::handle(std::string_view line) {
+    const auto received = std::chrono::steady_clock::now();
+    Op op = InvalidOp;
+    std::string response = answer(line, op);
+    latency_[op].record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - received).count()));
+    return response;
+}
+
+std::string QueryServer::answer(std::string_view line, Op& op) {
+    std::string out = "{\"id\":";
+    std::string_view id = "null";
+    try {
+        JsonValue root = JsonParser(line).parseDocument();
+        Request request(root);
+        if (const JsonValue* value = request.find("id")) id = value->raw;
+        out += id;
+
+        const std::string name = request.text("op", "path");
+        if (name == "path") {
+            op = PathOp;
+            const Cell start = request.cell("start", maze_);
+            const Cell dest = request.cell("dest", maze_);
+            const Algorithm algorithm = parse_algorithm(request.text("algorithm", "astar"));
+            SearchOptions options;
+            options.heuristic = parse_heuristic(request.text("heuristic", "manhattan"));
+            // The pool already uses every core, so parallel engines default to one
+            // thread, and a client may never ask for more than there are cores
+            options.threads = std::min(request.count("threads", 1), resolve_threads(0));
+            options.max_expansions = request.count("max_expansions", 0);
+            if (const std::size_t timeout = request.count("timeout_ms", 0)) {
+                options.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+            }
+
+            // Unbudgeted queries go through the path cache; budgeted ones must run
+            SearchResult result;
+            if (options.max_expansions == 0 && !options.deadline) {
+                result.path = maze_.findPath(algorithm, start, dest, options);
+                result.status = result.path.empty() && !(start == dest)
+                    ? SearchStatus::NoPath : SearchStatus::Found;
+            } else {
+                result = maze_.search(algorithm, start, dest, options);
+            }
+
+            float cost = 0.0f;
+            std::string directions;
+            directions.reserve(result.path.size());
+            Cell current = start;
+            for (Direction dir : result.path) {
+                current.move(dir);
+                cost += std::as_const(maze_).at_unchecked(current).weight;
+                directions.push_back("LRUD"[dir]);
+            }
+
+            out += ",\"status\":\"";
+            out += status_name(result.status);
+            out += "\",\"length\":" + std::to_string(result.path.size());
+            // A budget-cut ARA* run can still hold a complete, if unproven, path
+            if (current == dest) {
+                // Shortest round-trip form, so integral costs print without decimals
+                char digits[32];
+                auto end = std::to_chars(digits, digits + sizeof(digits), cost).ptr;
+                out += ",\"cost\":";
+                out.append(digits, end);
+            }
+            if (result.expansions > 0) out += ",\"expansions\":" + std::to_string(result.expansions);
+            if (request.flag("path", true)) {
+                out += ",\"path\":";
+                append_escaped(out, directions);
+            }
+        } else if (name == "connected") {
+            op = ConnectedOp;
+            const Cell a = request.cell("a", maze_);
+            const Cell b = request.cell("b", maze_);
+            out += std::string(",\"connected\":") + (maze_.connected(a, b) ? "true" : "false");
+        } else if (name == "info") {
+            op = InfoOp;
+            out += ",\"width\":" + std::to_string(maze_.getWidth())
+                + ",\"height\":" + std::to_string(maze_.getHeight())
+                + ",\"fingerprint\":" + std::to_string(maze_.fingerprint())
+                + ",\"landmarks\":" + (maze_.landmarks() ? "true" : "false")
+                + ",\"workers\":" + std::to_string(worker_count_);
+        } else if (name == "stats") {
+            op = StatsOp;
+            out += ",\"stats\":" + statsJson();
+        } else {
+            throw std::invalid_argument("Unknown op: " + name);
+        }
+    } catch (const std::exception& error) {
+        op = InvalidOp;
+        out = "{\"id\":";
+        out += id;
+        out += ",\"error\":";
+        append_escaped(out, error.what());
+    }
+    out += '}';
+    return out;
+}
+
+std::string QueryServer::statsJson() const {
+    std::string out = "{";
+    for (std::size_t op = 0; op < kOpCount; ++op) {
+        if (op > 0) out.push_back(',');
+        out += '"';
+        out += kOpNames[op];
+        out += "\":";
+        latency_[op].writeJson(out);
+    }
+    const PathCache::Stats cache = maze_.pathCacheStats();
+    out += ",\"cache\":{\"hits\":" + std::to_string(cache.hits)
+        + ",\"misses\":" + std::to_string(cache.misses)
+        + ",\"evictions\":" + std::to_string(cache.evictions) + "}}";
+    return out;
+}
+
+void QueryServer::submit(std::string line, const std::shared_ptr<Sink>& sink) {
+    {
+        std::lock_guard<std::mutex> lock(sink->mutex);
+        ++sink->pending;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        queue_.push_back({std::move(line), sink, std::chrono::steady_clock::now()});
+    }
+    queue_ready_.notify_one();
+}
+
+void QueryServer::drain(Sink& sink) {
+    std::unique_lock<std::mutex> lock(sink.mutex);
+    sink.idle.wait(lock, [&sink] { return sink.pending == 0; });
+}
+
+void QueryServer::worker_loop() {
+    std::vector<Job> batch;
+    batch.reserve(kMaxBatch);
+    while (true) {
+        {
+            // Taking several requests per wakeup amortizes the queue lock under load
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;
+            const std::size_t share = std::max<std::size_t>(1, queue_.size() / worker_count_);
+            const std::size_t take = std::min({share, kMaxBatch, queue_.size()});
+            for (std::size_t i = 0; i < take; ++i) {
+                batch.push_back(std::move(queue_.front()));
+                queue_.pop_front();
+            }
+        }
+
+        for (Job& job : batch) {
+            MAZE_TRACE_SCOPE("server", "request");
+            Op op = InvalidOp;
+            std::string response = answer(job.line, op);
+            response.push_back('\n');
+            latency_[op].record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - job.received).count()));
+
+            std::lock_guard<std::mutex> lock(job.sink->mutex);
+            job.sink->write(response);
+            if (--job.sink->pending == 0) job.sink->idle.notify_all();
+        }
+        batch.clear();
+    }
+}
+
+void QueryServer::serve(std::istream& in, std::ostream& out) {
+    auto sink = std::make_shared<Sink>();
+    sink->write = [&out](const std::string& response) {
+        out << response;
+        out.flush();
+    };
+    for (std::string line; std::getline(in, line);) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        submit(std::move(line), sink);
+    }
+    drain(*sink);
+}
+
+#ifndef _WIN32
+void QueryServer::serveSocket(const std::string& path, const std::atomic<bool>& stop) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + path);
+    }
+    std::copy(path.begin(), path.end(), address.sun_path);
+
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) throw std::runtime_error("Cannot create socket");
+    ::unlink(path.c_str());
+    if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0
+        || ::listen(listener, 16) < 0) {
+        ::close(listener);
+        throw std::runtime_error("Cannot listen on " + path);
+    }
+
+    // Each client gets a reader thread; its requests share the worker pool.
+    // Readers raise `done` on the way out so the accept loop can join them
+    struct Reader {
+        std::shared_ptr<std::atomic<bool>> done;
+        std::jthread thread;
+    };
+    std::vector<Reader> clients;
+    while (!stop.load()) {
+        std::erase_if(clients, [](const Reader& reader) {
+            return reader.done->load(std::memory_order_acquire);
+        });
+        pollfd ready{listener, POLLIN, 0};
+        if (::poll(&ready, 1, 200) <= 0) continue;  // Wake up to check `stop`
+        const int client = ::accept(listener, nullptr, nullptr);
+        if (client < 0) continue;
+
+        auto done = std::make_shared<std::atomic<bool>>(false);
+        clients.push_back({done, std::jthread([this, client, done, &stop] {
+            auto sink = std::make_shared<Sink>();
+            sink->write = [client](const std::string& response) {
+                std::size_t sent = 0;
+                while (sent < response.size()) {
+                    ssize_t n = ::send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+                    if (n < 0 && errno == EINTR) continue;
+                    if (n <= 0) return;  // Client went away; drop the rest
+                    sent += static_cast<std::size_t>(n);
+                }
+            };
+
+            std::string buffer;
+            char chunk[4096];
+            while (!stop.load()) {
+                pollfd readable{client, POLLIN, 0};
+                const int polled = ::poll(&readable, 1, 200);
+                if (polled == 0 || (polled < 0 && errno == EINTR)) continue;
+                if (polled < 0) break;  // The descriptor is unusable; hang up
+                ssize_t n = ::recv(client, chunk, sizeof(chunk), 0);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) break;
+                buffer.append(chunk, static_cast<std::size_t>(n));
+                std::size_t begin = 0;
+                for (std::size_t end; (end = buffer.find('\n', begin)) != std::string::npos; begin = end + 1) {
+                    std::string line = buffer.substr(begin, end - begin);
+                    if (line.find_first_not_of(" \t\r") != std::string::npos) submit(std::move(line), sink);
+                }
+                buffer.erase(0, begin);
+                if (buffer.size() > kMaxLineBytes) {
+                    // Nothing useful can follow a runaway line, so answer once and hang up
+                    std::lock_guard<std::mutex> lock(sink->mutex);
+                    sink->write("{\"id\":null,\"error\":\"Request line exceeds "
+                        + std::to_string(kMaxLineBytes) + " bytes\"}\n");
+                    break;
+                }
+            }
+            drain(*sink);
+            ::close(client);
+            done->store(true, std::memory_order_release);
+        })});
+    }
+    clients.clear();  // Joins the readers
+    ::close(listener);
+    ::unlink(path.c_str());
+}
+#else
+void QueryServer::serveSocket(const std::string&, const std::atomic<bool>&) {
+    throw std::runtime_error("Unix domain sockets are not supported on this platform");
+}
+#endif
+
+}  // namespace maze::server
@@ -5,22 +5,52 @@
 #include <ftxui/dom/elements.hpp>
 #include <ftxui/screen/color.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <utility>
 
 namespace maze::ui {
 
 namespace {
 
-constexpr std::chrono::milliseconds kExploreDelay{12};
-constexpr std::chrono::milliseconds kPulseDelay{24};
+std::string format_fixed(double value, int precision) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(precision) << value;
+    return out.str();
+}
+
+// New origin along one axis of a `view`-long window over `extent` cells
+std::size_t follow_axis(std::size_t origin, std::size_t pos, std::size_t view,
+    std::size_t extent, std::size_t margin) {
+    margin = std::min(margin, (view - 1) / 2);
+    if (pos < origin + margin) {
+        origin = pos > margin ? pos - margin : 0;
+    } else if (pos + margin >= origin + view) {
+        origin = pos + margin + 1 - view;
+    }
+    return std::min(origin, extent - view);
+}
+
+// Density glyph: blank for none, then light to full shade
+const char* shade(double fraction) {
+    static constexpr const char* kShades[] = {" ", "░", "▒", "▓", "█"};
+    if (fraction <= 0.0) return kShades[0];
+    return kShades[1 + static_cast<std::size_t>(std::min(fraction, 1.0) * 3.0)];
+}
 
 }  // namespace
 
-MazeApp::MazeApp(std::size_t width, std::size_t height)
+MazeApp::MazeApp(std::size_t width, std::size_t height, std::optional<std::uint64_t> seed)
     : width_(width),
       height_(height),
       maze_(width, height),
-      rng_(std::random_device{}()),
+      seed_(seed ? *seed : std::random_device{}()),
       wall_cell_{true, '#', Color::gray, 10.0f},
       passage_cell_{false, ' ', Color::white, 1.0f} {
     terrains_ = {
@@ -37,13 +67,16 @@ MazeApp::MazeApp(std::size_t width, std::size_t height)
         }}
     };
 
-    algorithm_labels_ = {"BFS", "DFS", "Dijkstra", "A*", "Greedy Best-First"};
+    algorithm_labels_ = {"BFS", "DFS", "Dijkstra", "A*", "Greedy Best-First", "ARA*", "Delta-Stepping", "Parallel BFS"};
     algorithm_values_ = {
         Algorithm::BFS,
         Algorithm::DFS,
         Algorithm::Dijkstra,
         Algorithm::AStar,
-        Algorithm::GreedyBestFirst
+        Algorithm::GreedyBestFirst,
+        Algorithm::ARAStar,
+        Algorithm::DeltaStepping,
+        Algorithm::ParallelBFS
     };
 
     generator_labels_ = {"Recursive Backtracker", "Prim", "Kruskal"};
@@ -66,11 +99,17 @@ MazeApp::MazeApp(std::size_t width, std::size_t height)
     grid_renderer_ = ftxui::Renderer([this] { return render_grid(); });
     root_ = ftxui::Container::Horizontal({menu_container_, grid_renderer_});
     renderer_ = ftxui::Renderer(root_, [this] {
-        return ftxui::hbox({
+        MAZE_TRACE_SCOPE("ui", "render");
+        auto began = std::chrono::steady_clock::now();
+        advance_replay();
+        update_viewport();
+        auto frame = ftxui::hbox({
             render_sidebar(),
             ftxui::separator(),
             grid_renderer_->Render()
         }) | ftxui::border;
+        note_frame(began, std::chrono::steady_clock::now());
+        return frame;
     });
 
     regenerate();
@@ -81,6 +120,7 @@ MazeApp::~MazeApp() {
 }
 
 void MazeApp::run() {
+    if (Tracer::instance().enabled()) Tracer::instance().nameThread("ui");
     ftxui::ScreenInteractive screen = ftxui::ScreenInteractive::Fullscreen();
     screen_ = &screen;
 
@@ -88,23 +128,32 @@ void MazeApp::run() {
         return handle_event(event);
     });
 
+    // Replays advance on the UI thread, so something has to keep asking for frames
+    std::jthread ticker([this](std::stop_token stop) {
+        while (!stop.stop_requested()) {
+            std::this_thread::sleep_for(kFrameInterval);
+            if (replay_running_.load() || solving_.load()) {
+                screen_->PostEvent(ftxui::Event::Custom);
+            }
+        }
+    });
+
     screen.Loop(app);
+    ticker.request_stop();
+    ticker.join();
     screen_ = nullptr;
     stop_solver();
 }
 
 void MazeApp::regenerate() {
     if (solving_.load()) return;
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    maze_.generate(generator_values_[generator_index_], wall_cell_, passage_cell_);
+    auto lock = lock_state();
+    // Each new maze takes the next seed in a chain from the starting seed
+    if (!first_maze_) seed_ = mix64(seed_);
+    first_maze_ = false;
+    maze_.generate(generator_values_[generator_index_], wall_cell_, passage_cell_, seed_);
     apply_terrain();
-    visited_.clear();
-    frontier_.clear();
-    solution_index_.clear();
-    solution_cells_.clear();
-    show_solution_ = false;
-    pulse_index_ = 0;
-    current_cell_.reset();
+    clear_replay();
     start_ = find_first_passage(false);
     dest_ = find_first_passage(true);
     cursor_ = start_;
@@ -115,59 +164,114 @@ void MazeApp::begin_solve() {
     stop_solver();
     solving_ = true;
     stop_requested_ = false;
+    race_entries_.clear();
+    {
+        auto lock = lock_state();
+        clear_replay();
+    }
 
-    solver_thread_ = std::thread([this] {
+    solver_thread_ = std::thread([this, algorithm = algorithm_values_[algorithm_index_]] {
+        if (Tracer::instance().enabled()) Tracer::instance().nameThread("solver");
+
+        // The search runs flat out and records what it expands; the UI replays
+        // the trace at whatever speed the user picks. Raising stop_requested_
+        // cancels the search itself.
+        ExplorationTrace trace(width_);
+        SearchOptions options;
+        options.trace = &trace;
+        options.cancel = &stop_requested_;
+        Path path = maze_.findPath(algorithm, start_, dest_, options);
+
+        std::vector<std::uint32_t> expanded_at;
         {
-            std::lock_guard<std::mutex> lock(state_mutex_);
-            visited_.clear();
-            frontier_.clear();
-            solution_index_.clear();
-            solution_cells_.clear();
-            show_solution_ = false;
-            pulse_index_ = 0;
-            current_cell_.reset();
+            MAZE_TRACE_SCOPE("solver", "index trace");
+            // Engines that reopen cells expand them more than once; keep the first
+            expanded_at.assign(width_ * height_, std::numeric_limits<std::uint32_t>::max());
+            trace.forEach([&](std::size_t step, Cell cell) {
+                auto& slot = expanded_at[cell.row * width_ + cell.col];
+                slot = std::min(slot, static_cast<std::uint32_t>(step));
+            });
+        }
+        auto cells = path.empty() ? std::vector<Cell>{} : build_cell_path(path);
+
+        if (!stop_requested_.load()) {
+            auto lock = lock_state();
+            trace_ = std::move(trace);
+            expanded_at_ = std::move(expanded_at);
+            solution_cells_ = std::move(cells);
+            rebuild_solution_index();
+            replay_paused_ = false;
+            seek_replay(0.0);
         }
 
-        ExploreCallback callback = [this](const Cell& current,
-            const std::vector<Cell>& frontier_cells,
-            const std::unordered_set<Cell>& visited_cells) {
-            if (stop_requested_.load()) return;
-            std::lock_guard<std::mutex> lock(state_mutex_);
-            current_cell_ = current;
-            visited_ = visited_cells;
-            frontier_.clear();
-            frontier_.insert(frontier_cells.begin(), frontier_cells.end());
-            if (screen_) screen_->PostEvent(ftxui::Event::Custom);
-            std::this_thread::sleep_for(kExploreDelay);
-        };
-
-        Path path = maze_.findPath(
-            algorithm_values_[algorithm_index_], start_, dest_, callback);
-
-        if (!path.empty() && !stop_requested_.load()) {
-            auto cells = build_cell_path(path);
-            {
-                std::lock_guard<std::mutex> lock(state_mutex_);
-                solution_cells_ = cells;
-                rebuild_solution_index();
-                show_solution_ = true;
-            }
+        solving_ = false;
+        if (screen_) screen_->PostEvent(ftxui::Event::Custom);
+    });
+}
 
-            for (std::size_t i = 0; i < cells.size(); ++i) {
-                if (stop_requested_.load()) break;
-                {
-                    std::lock_guard<std::mutex> lock(state_mutex_);
-                    pulse_index_ = i;
+void MazeApp::begin_race() {
+    if (solving_.load()) return;
+    stop_solver();
+    solving_ = true;
+    stop_requested_ = false;
+
+    // Lanes are replaced only here, on the UI thread, while no race is running
+    race_entries_ = std::vector<RaceEntry>(algorithm_values_.size());
+    for (std::size_t i = 0; i < race_entries_.size(); ++i) {
+        race_entries_[i].algorithm = algorithm_values_[i];
+    }
+    race_started_ = std::chrono::steady_clock::now();
+
+    {
+        auto lock = lock_state();
+        clear_replay();
+    }
+
+    solver_thread_ = std::thread([this] {
+        if (Tracer::instance().enabled()) Tracer::instance().nameThread("solver");
+        {
+            std::jthread runner([this] {
+                SearchOptions options;
+                options.cancel = &stop_requested_;
+                try {
+                    maze_.race(start_, dest_, race_entries_, options);
+                } catch (const std::exception& error) {
+                    // Rejected before (or while) starting lanes; every lane that
+                    // did start has joined, so close the rest or the wait below hangs
+                    for (RaceEntry& entry : race_entries_) {
+                        if (entry.finished.load(std::memory_order_acquire)) continue;
+                        entry.error = error.what();
+                        entry.finished.store(true, std::memory_order_release);
+                    }
                 }
-                if (screen_) screen_->PostEvent(ftxui::Event::Custom);
-                std::this_thread::sleep_for(kPulseDelay);
+            });
+            auto all_finished = [this] {
+                return std::ranges::all_of(race_entries_, [](const RaceEntry& entry) {
+                    return entry.finished.load(std::memory_order_acquire);
+                });
+            };
+            // The UI ticker redraws the lanes while the race runs
+            while (!all_finished()) {
+                std::this_thread::sleep_for(kFrameInterval);
             }
+        }
 
-            {
-                std::lock_guard<std::mutex> lock(state_mutex_);
-                pulse_index_ = cells.size();
+        // Show the cheapest path, breaking ties by wall-clock time
+        const RaceEntry* winner = nullptr;
+        for (const RaceEntry& entry : race_entries_) {
+            if (entry.path.empty()) continue;
+            if (!winner || entry.cost < winner->cost
+                || (entry.cost == winner->cost && entry.elapsed < winner->elapsed)) {
+                winner = &entry;
             }
         }
+        if (winner) {
+            auto lock = lock_state();
+            solution_cells_ = build_cell_path(winner->path);
+            rebuild_solution_index();
+            // Races record no trace, so the winner's path is shown whole
+            seek_replay(static_cast<double>(replay_length()));
+        }
 
         solving_ = false;
         if (screen_) screen_->PostEvent(ftxui::Event::Custom);
@@ -186,14 +290,73 @@ void MazeApp::rebuild_solution_index() {
     for (std::size_t i = 0; i < solution_cells_.size(); ++i) {
         solution_index_[solution_cells_[i]] = i;
     }
+
+    const std::size_t block = minimap_block();
+    const std::size_t cols = (width_ + block - 1) / block;
+    solution_blocks_.assign(cols * ((height_ + block - 1) / block), 0);
+    for (const Cell& cell : solution_cells_) {
+        ++solution_blocks_[(cell.row / block) * cols + cell.col / block];
+    }
+}
+
+void MazeApp::clear_replay() {
+    trace_.clear(width_);
+    expanded_at_.clear();
+    solution_index_.clear();
+    solution_cells_.clear();
+    seek_replay(0.0);
+}
+
+std::size_t MazeApp::replay_length() const {
+    return trace_.size() + solution_cells_.size();
+}
+
+void MazeApp::advance_replay() {
+    auto lock = lock_state();
+    const auto now = std::chrono::steady_clock::now();
+    if (!replay_paused_) {
+        const double seconds = std::chrono::duration<double>(now - replay_tick_).count();
+        seek_replay(replay_position_ + seconds * kReplayRate * replay_speed_);
+    }
+    replay_tick_ = now;
+}
+
+void MazeApp::seek_replay(double position) {
+    const std::size_t length = replay_length();
+    replay_position_ = std::clamp(position, 0.0, static_cast<double>(length));
+    const bool was_running = replay_running_.load();
+    replay_running_ = !replay_paused_ && replay_position_ < static_cast<double>(length);
+    // Time spent paused or finished must not count once playback resumes
+    if (replay_running_ && !was_running) replay_tick_ = std::chrono::steady_clock::now();
+
+    // The first trace.size() steps expand cells; the rest walk the solution
+    const auto step = static_cast<std::size_t>(replay_position_);
+    explored_steps_ = std::min(step, trace_.size());
+    current_cell_.reset();
+    if (explored_steps_ > 0) current_cell_ = trace_.at(explored_steps_ - 1);
+    show_solution_ = !solution_cells_.empty() && step >= trace_.size();
+    pulse_index_ = show_solution_ ? step - trace_.size() : 0;
 }
 
 bool MazeApp::handle_event(const ftxui::Event& event) {
+    MAZE_TRACE_SCOPE("ui", "event");
     if (event == ftxui::Event::Tab) {
         focus_on_grid_ = !focus_on_grid_;
         return true;
     }
 
+    if (event == ftxui::Event::Character('f')
+        || event == ftxui::Event::Character('F')) {
+        show_frame_stats_ = !show_frame_stats_;
+        return true;
+    }
+
+    if (event == ftxui::Event::Character('m')
+        || event == ftxui::Event::Character('M')) {
+        show_minimap_ = !show_minimap_;
+        return true;
+    }
+
     if (event == ftxui::Event::Character('q')
         || event == ftxui::Event::Character('Q')) {
         stop_requested_ = true;
@@ -224,16 +387,60 @@ bool MazeApp::handle_grid_event(const ftxui::Event& event) {
         cursor_.col++;
         return true;
     }
+    if (event == ftxui::Event::PageUp) {
+        cursor_.row -= std::min(cursor_.row, std::max<std::size_t>(view_rows_, 1));
+        return true;
+    }
+    if (event == ftxui::Event::PageDown) {
+        cursor_.row = std::min(cursor_.row + std::max<std::size_t>(view_rows_, 1), height_ - 1);
+        return true;
+    }
+    if (event == ftxui::Event::Character('p')
+        || event == ftxui::Event::Character('P')) {
+        auto lock = lock_state();
+        replay_paused_ = !replay_paused_;
+        seek_replay(replay_position_);
+        return true;
+    }
+    if (event == ftxui::Event::Character('+')
+        || event == ftxui::Event::Character('=')) {
+        auto lock = lock_state();
+        replay_speed_ = std::min(replay_speed_ * 2.0, kMaxReplaySpeed);
+        return true;
+    }
+    if (event == ftxui::Event::Character('-')) {
+        auto lock = lock_state();
+        replay_speed_ = std::max(replay_speed_ / 2.0, kMinReplaySpeed);
+        return true;
+    }
+    if (event == ftxui::Event::Character('[')
+        || event == ftxui::Event::Character(']')) {
+        // Scrub by a hundredth of the timeline, at least one step
+        auto lock = lock_state();
+        const double stride = std::max(1.0, static_cast<double>(replay_length()) / 100.0);
+        seek_replay(replay_position_ + (event == ftxui::Event::Character('[') ? -stride : stride));
+        return true;
+    }
+    if (event == ftxui::Event::Home) {
+        auto lock = lock_state();
+        seek_replay(0.0);
+        return true;
+    }
+    if (event == ftxui::Event::End) {
+        auto lock = lock_state();
+        seek_replay(static_cast<double>(replay_length()));
+        return true;
+    }
     if (event == ftxui::Event::Character('s')
         || event == ftxui::Event::Character('S')) {
-        if (!maze_.at_unchecked(cursor_).wall) {
+        if (!std::as_const(maze_).at_unchecked(cursor_).wall) {
             start_ = cursor_;
         }
         return true;
     }
     if (event == ftxui::Event::Character('d')
         || event == ftxui::Event::Character('D')) {
-        if (!maze_.at_unchecked(cursor_).wall) {
+        if (!std::as_const(maze_).at_unchecked(cursor_).wall) {
             dest_ = cursor_;
         }
         return true;
@@ -247,6 +454,11 @@ bool MazeApp::handle_grid_event(const ftxui::Event& event) {
         begin_solve();
         return true;
     }
+    if (event == ftxui::Event::Character('a')
+        || event == ftxui::Event::Character('A')) {
+        begin_race();
+        return true;
+    }
     return false;
 }
 
@@ -259,23 +471,82 @@ bool MazeApp::handle_menu_event(const ftxui::Event& event) {
     return handled;
 }
 
+std::unique_lock<std::mutex> MazeApp::lock_state() {
+    MAZE_TRACE_SCOPE("ui", "lock wait");
+    return std::unique_lock<std::mutex>(state_mutex_);
+}
+
+void MazeApp::note_frame(std::chrono::steady_clock::time_point began,
+    std::chrono::steady_clock::time_point ended) {
+    using Millis = std::chrono::duration<double, std::milli>;
+    const std::size_t slot = frames_ % kFrameWindow;
+    frame_ms_[slot] = Millis(ended - began).count();
+    frame_gap_ms_[slot] = frames_ > 0 ? Millis(began - last_frame_).count() : 0.0;
+    last_frame_ = began;
+    ++frames_;
+}
+
+ftxui::Element MazeApp::render_frame_stats() {
+    if (!show_frame_stats_) return ftxui::emptyElement();
+
+    // The first frame has no gap before it, so skip it when averaging FPS
+    const std::size_t frames = std::min(frames_, kFrameWindow);
+    double total = 0.0, worst = 0.0, gaps = 0.0;
+    std::size_t gap_count = 0;
+    for (std::size_t i = 0; i < frames; ++i) {
+        total += frame_ms_[i];
+        worst = std::max(worst, frame_ms_[i]);
+        if (frame_gap_ms_[i] > 0.0) {
+            gaps += frame_gap_ms_[i];
+            ++gap_count;
+        }
+    }
+    const double average = frames > 0 ? total / static_cast<double>(frames) : 0.0;
+    const double fps = gaps > 0.0 ? 1000.0 * static_cast<double>(gap_count) / gaps : 0.0;
+
+    std::vector<ftxui::Element> lines{
+        ftxui::separator(),
+        ftxui::text("Frame: " + format_fixed(average, 2) + " ms avg, "
+            + format_fixed(worst, 2) + " ms max"),
+        ftxui::text("FPS: " + format_fixed(fps, 1))
+    };
+    if (Tracer::instance().enabled()) {
+        auto [events, dropped] = Tracer::instance().counts();
+        lines.push_back(ftxui::text("Trace: " + std::to_string(events) + " events"
+            + (dropped > 0 ? ", " + std::to_string(dropped) + " dropped" : "")));
+    }
+    return ftxui::vbox(std::move(lines));
+}
+
 ftxui::Element MazeApp::render_grid() {
-    std::lock_guard<std::mutex> lock(state_mutex_);
+    MAZE_TRACE_SCOPE("ui", "render grid");
+    auto lock = lock_state();
     std::vector<ftxui::Element> rows;
-    rows.reserve(height_);
+    rows.reserve(view_rows_);
 
-    for (std::size_t r = 0; r < height_; ++r) {
+    // Only the visible cells get elements, so cost follows the pane, not the maze
+    const std::size_t row_end = view_origin_.row + view_rows_;
+    const std::size_t col_end = view_origin_.col + view_cols_;
+    for (std::size_t r = view_origin_.row; r < row_end; ++r) {
         std::vector<ftxui::Element> cells;
-        cells.reserve(width_);
-        for (std::size_t c = 0; c < width_; ++c) {
+        cells.reserve(view_cols_);
+        for (std::size_t c = view_origin_.col; c < col_end; ++c) {
             Cell cell{r, c};
-            const auto& meta = maze_.at_unchecked(cell);
+            const auto& meta = std::as_const(maze_).at_unchecked(cell);
             bool is_wall = meta.wall;
             bool is_cursor = focus_on_grid_ && (cell == cursor_);
             bool is_start = (cell == start_);
             bool is_dest = (cell == dest_);
-            bool is_frontier = frontier_.contains(cell);
-            bool is_visited = visited_.contains(cell);
+            bool is_visited = explored(cell);
+            // The frontier is derived, not recorded: unexplored passages
+            // next to explored ones
+            bool is_frontier = false;
+            if (!is_wall && !is_visited && explored_steps_ > 0) {
+                for (std::uint8_t di = 0; di < Direction::COUNT && !is_frontier; ++di) {
+                    auto dir = static_cast<Direction>(di);
+                    is_frontier = cell.hasDir(dir, width_, height_) && explored(cell.toward(dir));
+                }
+            }
             bool is_current = current_cell_.has_value() && (cell == *current_cell_);
 
             std::string glyph = is_wall ? "█" : "·";
@@ -330,7 +601,127 @@ ftxui::Element MazeApp::render_grid() {
         }
         rows.push_back(ftxui::hbox(cells));
     }
-    return ftxui::vbox(rows) | ftxui::border;
+    return ftxui::vbox(rows) | ftxui::flex | ftxui::reflect(grid_box_) | ftxui::border;
+}
+
+void MazeApp::update_viewport() {
+    auto lock = lock_state();
+    const auto pane_rows = static_cast<std::size_t>(std::max(grid_box_.y_max - grid_box_.y_min + 1, 1));
+    const auto pane_cols = static_cast<std::size_t>(std::max(grid_box_.x_max - grid_box_.x_min + 1, 1));
+    const std::size_t rows = std::min(height_, pane_rows);
+    const std::size_t cols = std::min(width_, pane_cols);
+
+    // The pane is measured during layout, after this frame's elements exist.
+    // Redraw once more whenever it changes so startup and resizes settle.
+    const bool resized = rows != view_rows_ || cols != view_cols_;
+    view_rows_ = rows;
+    view_cols_ = cols;
+    if (resized && screen_) screen_->PostEvent(ftxui::Event::Custom);
+
+    std::optional<Cell> focus;
+    if (cursor_ != followed_cursor_) {
+        focus = cursor_;
+    } else if (current_cell_ && current_cell_ != followed_current_) {
+        focus = current_cell_;
+    } else if (resized) {
+        focus = cursor_;
+    }
+    followed_cursor_ = cursor_;
+    followed_current_ = current_cell_;
+    if (focus) scroll_to(*focus);
+}
+
+void MazeApp::scroll_to(Cell focus) {
+    view_origin_.row = follow_axis(view_origin_.row, focus.row, view_rows_, height_, kViewMargin);
+    view_origin_.col = follow_axis(view_origin_.col, focus.col, view_cols_, width_, kViewMargin);
+}
+
+std::size_t MazeApp::minimap_block() const {
+    const std::size_t by_rows = (height_ + kMinimapRows - 1) / kMinimapRows;
+    const std::size_t by_cols = (width_ + kMinimapCols - 1) / kMinimapCols;
+    return std::max<std::size_t>(std::max(by_rows, by_cols), 1);
+}
+
+ftxui::Element MazeApp::render_minimap() {
+    if (!show_minimap_ || (view_rows_ >= height_ && view_cols_ >= width_)) {
+        return ftxui::emptyElement();
+    }
+    MAZE_TRACE_SCOPE("ui", "render minimap");
+    auto lock = lock_state();
+
+    // Each glyph shades a fixed sample of its block, so the cost is set by
+    // the minimap size whatever the maze size
+    const std::size_t block = minimap_block();
+    const std::size_t step = (block + kMinimapSamples - 1) / kMinimapSamples;
+    const std::size_t block_rows = (height_ + block - 1) / block;
+    const std::size_t block_cols = (width_ + block - 1) / block;
+    const Cell view_end{view_origin_.row + view_rows_, view_origin_.col + view_cols_};
+
+    std::vector<ftxui::Element> rows;
+    rows.reserve(block_rows);
+    for (std::size_t br = 0; br < block_rows; ++br) {
+        const std::size_t r0 = br * block;
+        const std::size_t r1 = std::min(r0 + block, height_);
+        std::vector<ftxui::Element> glyphs;
+        glyphs.reserve(block_cols);
+        for (std::size_t bc = 0; bc < block_cols; ++bc) {
+            const std::size_t c0 = bc * block;
+            const std::size_t c1 = std::min(c0 + block, width_);
+
+            std::size_t samples = 0, walls = 0, explored = 0;
+            for (std::size_t r = r0; r < r1; r += step) {
+                for (std::size_t c = c0; c < c1; c += step) {
+                    Cell cell{r, c};
+                    ++samples;
+                    if (std::as_const(maze_).at_unchecked(cell).wall) ++walls;
+                    if (this->explored(cell)) ++explored;
+                }
+            }
+
+            const std::uint32_t on_path = show_solution_
+                ? solution_blocks_[br * block_cols + bc] : 0;
+            std::string glyph;
+            ftxui::Color fg;
+            if (on_path > 0) {
+                glyph = shade(static_cast<double>(on_path) / static_cast<double>(block));
+                fg = ftxui::Color::RGB(60, 220, 140);
+            } else if (explored > 0) {
+                glyph = shade(static_cast<double>(explored) / static_cast<double>(samples));
+                fg = ftxui::Color::RGB(90, 170, 255);
+            } else {
+                glyph = shade(static_cast<double>(walls) / static_cast<double>(samples));
+                fg = ftxui::Color::RGB(110, 110, 110);
+            }
+            auto within = [&](Cell cell) {
+                return cell.row >= r0 && cell.row < r1 && cell.col >= c0 && cell.col < c1;
+            };
+            if (within(start_)) {
+                glyph = "S";
+                fg = ftxui::Color::RGB(80, 240, 160);
+            }
+            if (within(dest_)) {
+                glyph = "D";
+                fg = ftxui::Color::RGB(255, 110, 110);
+            }
+
+            auto element = ftxui::text(glyph) | ftxui::color(fg);
+            bool in_view = r0 < view_end.row && r1 > view_origin_.row
+                && c0 < view_end.col && c1 > view_origin_.col;
+            if (in_view) element = element | ftxui::bgcolor(ftxui::Color::RGB(45, 45, 80));
+            glyphs.push_back(element);
+        }
+        rows.push_back(ftxui::hbox(std::move(glyphs)));
+    }
+
+    return ftxui::vbox({
+        ftxui::separator(),
+        ftxui::text("Map (" + std::to_string(block) + "x" + std::to_string(block)
+            + " cells per glyph)") | ftxui::bold,
+        ftxui::vbox(std::move(rows)),
+        ftxui::text("View: rows " + std::to_string(view_origin_.row) + "-"
+            + std::to_string(view_end.row - 1) + ", cols "
+            + std::to_string(view_origin_.col) + "-" + std::to_string(view_end.col - 1))
+    });
 }
 
 ftxui::Element MazeApp::render_sidebar() {
@@ -354,13 +745,26 @@ ftxui::Element MazeApp::render_sidebar() {
             + std::to_string(start_.col) + ")"),
         ftxui::text("Goal: (" + std::to_string(dest_.row) + ", "
             + std::to_string(dest_.col) + ")"),
+        ftxui::text("Seed: " + std::to_string(seed_)),
+        render_replay(),
+        render_minimap(),
+        render_race(),
+        render_frame_stats(),
         ftxui::separator(),
         ftxui::text("Controls") | ftxui::bold,
         ftxui::text("Arrows  Move cursor/menu"),
+        ftxui::text("PgUp/Dn Move cursor a page"),
         ftxui::text("Enter   Select menu"),
         ftxui::text("S/D     Set start/goal"),
         ftxui::text("Space   Solve"),
+        ftxui::text("A       Race all algorithms"),
+        ftxui::text("P       Pause/resume replay"),
+        ftxui::text("+/-     Replay speed"),
+        ftxui::text("[/]     Scrub replay"),
+        ftxui::text("Home/End Rewind/skip replay"),
         ftxui::text("R       Regenerate"),
+        ftxui::text("M       Minimap"),
+        ftxui::text("F       Frame stats"),
         ftxui::text("Tab     Switch focus"),
         ftxui::text("Q       Quit"),
         ftxui::separator(),
@@ -368,22 +772,63 @@ ftxui::Element MazeApp::render_sidebar() {
     }) | ftxui::border;
 }
 
+ftxui::Element MazeApp::render_replay() {
+    auto lock = lock_state();
+    const std::size_t length = replay_length();
+    if (length == 0) return ftxui::emptyElement();
+
+    const auto step = static_cast<std::size_t>(replay_position_);
+    std::string state = replay_paused_ ? "paused"
+        : replay_running_.load() ? format_fixed(replay_speed_, replay_speed_ < 1.0 ? 2 : 0) + "x"
+        : "done";
+    return ftxui::vbox({
+        ftxui::separator(),
+        ftxui::text("Replay: " + std::to_string(step) + "/" + std::to_string(length)
+            + " (" + state + ")"),
+        ftxui::gauge(static_cast<float>(replay_position_ / static_cast<double>(length))),
+        ftxui::text("Trace: " + std::to_string(trace_.size()) + " steps, "
+            + std::to_string(trace_.bytes()) + " bytes")
+    });
+}
+
+ftxui::Element MazeApp::render_race() {
+    if (race_entries_.empty()) return ftxui::emptyElement();
+
+    auto column = [](const std::string& value, int width) {
+        return ftxui::text(value) | ftxui::size(ftxui::WIDTH, ftxui::EQUAL, width);
+    };
+    std::vector<ftxui::Element> rows;
+    rows.push_back(ftxui::separator());
+    rows.push_back(ftxui::hbox({
+        column("Race", 18), column("Expanded", 9), column("ms", 8), column("Cost", 7)
+    }) | ftxui::bold);
+
+    auto now = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < race_entries_.size(); ++i) {
+        const RaceEntry& entry = race_entries_[i];
+        bool finished = entry.finished.load(std::memory_order_acquire);
+        auto elapsed = finished ? entry.elapsed : now - race_started_;
+        double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+        std::string cost = !finished ? "..."
+            : !entry.error.empty() ? "error"
+            : std::isfinite(entry.cost) ? format_fixed(entry.cost, 1) : "-";
+
+        auto row = ftxui::hbox({
+            column(algorithm_labels_[i], 18),
+            column(std::to_string(entry.expansions.load(std::memory_order_relaxed)), 9),
+            column(format_fixed(ms, 1), 8),
+            column(cost, 7)
+        });
+        rows.push_back(finished ? row : row | ftxui::dim);
+    }
+    return ftxui::vbox(std::move(rows));
+}
+
 void MazeApp::apply_terrain() {
     if (terrains_.empty()) return;
     const auto& preset = terrains_[terrain_index_];
     if (preset.passages.empty()) return;
-    std::uniform_int_distribution<std::size_t> pick(0, preset.passages.size() - 1);
-
-    for (std::size_t r = 0; r < height_; ++r) {
-        for (std::size_t c = 0; c < width_; ++c) {
-            Cell cell{r, c};
-            if (maze_.at_unchecked(cell).wall) {
-                maze_.at_unchecked(cell) = wall_cell_;
-            } else {
-                maze_.at_unchecked(cell) = preset.passages[pick(rng_)];
-            }
-        }
-    }
+    maze_.paintTerrain(preset.passages, seed_);
 }
 
 Cell MazeApp::find_first_passage(bool from_end) const {
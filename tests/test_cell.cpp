@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <utility>
 
 #include "maze/core/cell.hpp"
+#include "maze/core/cell_id.hpp"
 
 TEST_CASE("Cell navigation", "[cell]") {
     Cell cell{5, 5};
@@ -45,3 +48,36 @@ TEST_CASE("Direction reverse", "[direction]") {
     CHECK(reverse(Direction::up) == Direction::down);
     CHECK(reverse(Direction::down) == Direction::up);
 }
+
+TEST_CASE("Cell ids", "[cell][cell-id]") {
+    SECTION("round-trip through the grid width") {
+        for (Cell cell : {Cell{0, 0}, Cell{0, 6}, Cell{4, 0}, Cell{9, 6}}) {
+            CellId id = CellId::from(cell, 7);
+            CHECK(id.toCell(7) == cell);
+        }
+        CHECK(CellId::from({2, 3}, 7).index == 17);
+    }
+
+    SECTION("wide ids address cells past 32 bits") {
+        const std::size_t width = std::size_t{1} << 30;
+        Cell far{(std::size_t{1} << 30) - 1, width - 1};
+        WideCellId id = WideCellId::from(far, width);
+        CHECK(id.index == (std::uint64_t{1} << 60) - 1);
+        CHECK(id.toCell(width) == far);
+    }
+
+    SECTION("stay compact") {
+        STATIC_REQUIRE(sizeof(CellId) == 4);
+        STATIC_REQUIRE(sizeof(Direction) == 1);
+        STATIC_REQUIRE(sizeof(std::pair<float, CellId>) == 8);
+    }
+
+    SECTION("direction maps start unset") {
+        DirectionMap map(3, 2);
+        CellId id = CellId::from({1, 2}, 3);
+        CHECK_FALSE(map.contains(id));
+        map[id] = Direction::up;
+        CHECK(map.contains(id));
+        CHECK(map[id] == Direction::up);
+    }
+}
@@ -0,0 +1,88 @@
+#include <catch2/catch_test_macros.hpp>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+#include "maze/maze.hpp"
+
+namespace {
+
+const CellMetaData kWall{true, '#', Color::gray, 10.0f};
+const CellMetaData kPassage{false, ' ', Color::white, 1.0f};
+
+bool reachable(const Maze& maze, Cell a, Cell b) {
+    const std::size_t width = maze.getWidth();
+    const std::size_t height = maze.getHeight();
+    if (maze.at_unchecked(a).wall || maze.at_unchecked(b).wall) return false;
+    std::vector<bool> seen(width * height, false);
+    std::queue<Cell> queue;
+    queue.push(a);
+    seen[a.row * width + a.col] = true;
+    while (!queue.empty()) {
+        Cell cell = queue.front();
+        queue.pop();
+        if (cell == b) return true;
+        for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
+            Direction dir = static_cast<Direction>(d);
+            if (!cell.hasDir(dir, width, height)) continue;
+            Cell next = cell.toward(dir);
+            if (maze.at_unchecked(next).wall || seen[next.row * width + next.col]) continue;
+            seen[next.row * width + next.col] = true;
+            queue.push(next);
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+TEST_CASE("Component labels match flood fill", "[components]") {
+    // Tall enough to be split into several labeling stripes
+    Maze maze(40, 300);
+    std::vector<CellMetaData> cells{kWall, kPassage};
+    maze.generateRandom(cells, 0.45f);
+    maze.trackComponents(true, 4);
+
+    const Cell probes[] = {{0, 0}, {299, 39}, {150, 20}, {64, 3}, {128, 38}, {255, 0}};
+    for (Cell a : probes) {
+        for (Cell b : probes) {
+            CHECK(maze.connected(a, b) == reachable(maze, a, b));
+        }
+    }
+}
+
+TEST_CASE("Component tracking follows edits", "[components]") {
+    Maze maze(5, 3);
+    for (std::size_t r = 0; r < 3; ++r) {
+        for (std::size_t c = 0; c < 5; ++c) maze.setCell({r, c}, kPassage);
+    }
+    maze.trackComponents();
+    for (std::size_t r = 0; r < 3; ++r) maze.setCell({r, 2}, kWall);
+
+    SECTION("closing a column splits the region") {
+        CHECK_FALSE(maze.connected({0, 0}, {0, 4}));
+        CHECK(maze.findPath(Algorithm::BFS, {0, 0}, {0, 4}).empty());
+        CHECK_FALSE(maze.solve(Algorithm::AStar, {0, 0}, {0, 4}, false));
+    }
+
+    SECTION("opening a cell merges regions incrementally") {
+        REQUIRE_FALSE(maze.connected({0, 0}, {0, 4}));
+        maze.setCell({1, 2}, kPassage);
+        CHECK(maze.connected({0, 0}, {0, 4}));
+        CHECK_FALSE(maze.findPath(Algorithm::BFS, {0, 0}, {0, 4}).empty());
+    }
+
+    SECTION("writes through operator[] are picked up") {
+        maze[{1, 2}] = kPassage;
+        CHECK(maze.connected({0, 0}, {2, 4}));
+    }
+
+    SECTION("setCell is bounds checked") {
+        CHECK_THROWS_AS(maze.setCell({3, 0}, kWall), std::out_of_range);
+    }
+}
+
+TEST_CASE("Connectivity queries require tracking", "[components]") {
+    Maze maze(3, 3);
+    CHECK_THROWS_AS(maze.connected({0, 0}, {1, 1}), std::logic_error);
+}
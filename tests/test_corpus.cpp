@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "maze/corpus.hpp"
+
+namespace {
+
+const CellMetaData kWall{true, '#', Color::gray, 10.0f};
+const CellMetaData kPassage{false, ' ', Color::white, 1.0f};
+
+struct TempFile {
+    std::filesystem::path path;
+    explicit TempFile(const std::string& name)
+        : path(std::filesystem::temp_directory_path() / name) {}
+    ~TempFile() { std::filesystem::remove(path); }
+};
+
+std::vector<CorpusJob> mixed_jobs() {
+    std::vector<CorpusJob> jobs;
+    const GenerationAlgorithm generators[] = {
+        GenerationAlgorithm::RecursiveBacktracker, GenerationAlgorithm::Prim,
+        GenerationAlgorithm::Kruskal};
+    const std::size_t sizes[][2] = {{31, 21}, {15, 15}, {31, 21}, {64, 9}};
+    for (std::size_t i = 0; i < 12; ++i) {
+        CorpusJob job;
+        job.width = sizes[i % 4][0];
+        job.height = sizes[i % 4][1];
+        job.algorithm = generators[i % 3];
+        job.seed = 1000 + i;
+        if (i % 4 == 1) {
+            job.random_cells = {kWall, kPassage, {false, '~', Color::cyan, 3.0f}};
+            job.wall_density = 0.25f;
+        }
+        if (i % 5 == 2) {
+            job.terrain = {{false, '.', Color::green, 1.0f}, {false, ',', Color::green, 2.0f}};
+        }
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+// The same job run on its own, serially
+Maze expected_maze(const CorpusJob& job) {
+    Maze maze(job.width, job.height);
+    if (job.random_cells.empty()) {
+        maze.generate(job.algorithm, job.wall, job.passage, job.seed);
+    } else {
+        std::vector<CellMetaData> pool = job.random_cells;
+        maze.generateRandom(pool, job.wall_density, job.seed);
+    }
+    if (!job.terrain.empty()) maze.paintTerrain(job.terrain, job.seed);
+    return maze;
+}
+
+bool same_maze(const Maze& a, const Maze& b) {
+    if (a.getWidth() != b.getWidth() || a.getHeight() != b.getHeight()) return false;
+    for (std::size_t r = 0; r < a.getHeight(); ++r) {
+        for (std::size_t c = 0; c < a.getWidth(); ++c) {
+            const CellMetaData& x = a.at_unchecked({r, c});
+            const CellMetaData& y = b.at_unchecked({r, c});
+            if (x.wall != y.wall || x.glyph != y.glyph || x.color != y.color || x.weight != y.weight) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::string read_file(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+}  // namespace
+
+TEST_CASE("Corpus generation", "[corpus]") {
+    const std::vector<CorpusJob> jobs = mixed_jobs();
+    TempFile file("maze_corpus_test.bin");
+    std::vector<CorpusEntry> written = buildCorpus(file.path.string(), jobs, 3);
+    REQUIRE(written.size() == jobs.size());
+
+    SECTION("every maze reads back as generated, in any order") {
+        CorpusReader reader(file.path.string());
+        REQUIRE(reader.size() == jobs.size());
+        for (std::size_t i = jobs.size(); i-- > 0;) {
+            Maze expected = expected_maze(jobs[i]);
+            Maze loaded = reader.load(i);
+            CHECK(same_maze(loaded, expected));
+            CHECK(reader.entries()[i].fingerprint == expected.fingerprint());
+            CHECK(reader.entries()[i].seed == jobs[i].seed);
+            CHECK(reader.entries()[i].offset == written[i].offset);
+        }
+    }
+
+    SECTION("records are bit-packed by cell kind") {
+        // A plain perfect maze has two kinds of cell, so one bit each
+        const std::size_t cells = 31 * 21;
+        CHECK(written[0].bytes == 3 * 8 + 2 * 7 + (cells + 7) / 8);
+        // The random pool has three kinds, so two bits each
+        CHECK(written[5].bytes == 3 * 8 + 3 * 7 + (15 * 15 * 2 + 7) / 8);
+    }
+
+    SECTION("the file is the same for any thread count") {
+        TempFile serial("maze_corpus_test_serial.bin");
+        buildCorpus(serial.path.string(), jobs, 1);
+        CHECK(read_file(serial.path) == read_file(file.path));
+    }
+
+    SECTION("bad input throws") {
+        CorpusReader reader(file.path.string());
+        CHECK_THROWS_AS(reader.load(jobs.size()), std::out_of_range);
+
+        std::vector<CorpusJob> empty_job(1);
+        CHECK_THROWS_AS(buildCorpus(file.path.string(), empty_job), std::invalid_argument);
+
+        CorpusJob bad_density;
+        bad_density.width = bad_density.height = 5;
+        bad_density.random_cells = {kPassage};
+        bad_density.wall_density = 0.5f;  // No walls in the pool
+        CHECK_THROWS_AS(buildCorpus(file.path.string(), {bad_density}), std::invalid_argument);
+
+        std::ofstream(file.path, std::ios::binary | std::ios::trunc) << "not a corpus";
+        CHECK_THROWS_AS(CorpusReader(file.path.string()), std::runtime_error);
+    }
+
+    SECTION("an empty job list gives an empty corpus") {
+        buildCorpus(file.path.string(), {});
+        CHECK(CorpusReader(file.path.string()).size() == 0);
+    }
+}
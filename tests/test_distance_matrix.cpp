@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "maze/maze.hpp"
+
+namespace {
+
+// Two regions split by a solid wall column at 15. A wall row with a gap at
+// its right end makes the left region's top-to-bottom paths detour.
+Maze make_maze() {
+    Maze maze(24, 16);
+    for (std::size_t r = 0; r < 16; ++r) {
+        for (std::size_t c = 0; c < 24; ++c) {
+            const bool wall = c == 15 || (r == 8 && c < 12);
+            const float weight = 1.0f + static_cast<float>((r * 3 + c) % 5);
+            maze[{r, c}] = {wall, wall ? '#' : '.', Color::green, wall ? 10.0f : weight};
+        }
+    }
+    return maze;
+}
+
+// Left region, right region, a wall cell, then the first point again
+const std::vector<Cell> kPoints{{0, 0}, {15, 2}, {6, 10}, {3, 20}, {12, 23}, {8, 5}, {0, 0}};
+constexpr std::size_t kWallPoint = 5;
+constexpr std::size_t kRepeat = 6;
+
+bool same_region(std::size_t i, std::size_t j) {
+    return (kPoints[i].col > 15) == (kPoints[j].col > 15);
+}
+
+}  // namespace
+
+TEST_CASE("Distance matrices", "[distance-matrix]") {
+    Maze maze = make_maze();
+    REQUIRE(maze.at_unchecked(kPoints[kWallPoint]).wall);
+    const float inf = std::numeric_limits<float>::infinity();
+
+    SECTION("costs match one-to-all cost maps for every pair") {
+        DistanceMatrix matrix = maze.distanceMatrix(kPoints, 3);
+        REQUIRE(matrix.size() == kPoints.size());
+        REQUIRE(matrix.costs().size() == kPoints.size() * kPoints.size());
+        for (std::size_t i = 0; i < kPoints.size(); ++i) {
+            if (i == kWallPoint) continue;
+            CHECK(matrix.cost(i, i) == 0.0f);
+            const std::vector<float> costs = maze.costMap(kPoints[i], 1);
+            for (std::size_t j = 0; j < kPoints.size(); ++j) {
+                if (i == j) continue;
+                const float expected = j == kWallPoint ? inf : costs[kPoints[j].row * 24 + kPoints[j].col];
+                if (std::isinf(expected)) {
+                    CHECK(matrix.cost(i, j) == inf);
+                } else {
+                    CHECK(matrix.cost(i, j) == Catch::Approx(expected));
+                }
+            }
+        }
+    }
+
+    SECTION("wall points and other regions are unreachable") {
+        DistanceMatrix matrix = maze.distanceMatrix(kPoints, 2, true);
+        for (std::size_t i = 0; i < kPoints.size(); ++i) {
+            for (std::size_t j = 0; j < kPoints.size(); ++j) {
+                if (i == j || (i != kWallPoint && j != kWallPoint && same_region(i, j))) continue;
+                CHECK(matrix.cost(i, j) == inf);
+                CHECK(matrix.path(i, j).empty());
+            }
+        }
+    }
+
+    SECTION("a wall point's row and column are infinite, diagonal included") {
+        DistanceMatrix matrix = maze.distanceMatrix(kPoints, 2, true);
+        for (std::size_t j = 0; j < kPoints.size(); ++j) {
+            CHECK(matrix.cost(kWallPoint, j) == inf);
+            CHECK(matrix.cost(j, kWallPoint) == inf);
+        }
+        CHECK(matrix.path(kWallPoint, kWallPoint).empty());
+    }
+
+    SECTION("repeated points get identical rows and columns") {
+        DistanceMatrix matrix = maze.distanceMatrix(kPoints);
+        for (std::size_t j = 0; j < kPoints.size(); ++j) {
+            CHECK(matrix.cost(0, j) == matrix.cost(kRepeat, j));
+            CHECK(matrix.cost(j, 0) == matrix.cost(j, kRepeat));
+        }
+        CHECK(matrix.cost(0, kRepeat) == 0.0f);
+    }
+
+    SECTION("costs are charged on entry, so reversing swaps the end weights") {
+        DistanceMatrix matrix = maze.distanceMatrix(kPoints);
+        const float w0 = maze.at_unchecked(kPoints[0]).weight;
+        const float w1 = maze.at_unchecked(kPoints[1]).weight;
+        CHECK(matrix.cost(1, 0) == Catch::Approx(matrix.cost(0, 1) - w1 + w0));
+    }
+
+    SECTION("thread count and component tracking do not change the answer") {
+        std::vector<float> serial = maze.distanceMatrix(kPoints, 1).costs();
+        CHECK(maze.distanceMatrix(kPoints, 4).costs() == serial);
+        maze.trackComponents();
+        CHECK(maze.distanceMatrix(kPoints, 2).costs() == serial);
+    }
+
+    SECTION("paths are rebuilt on request") {
+        DistanceMatrix matrix = maze.distanceMatrix(kPoints, 2, true);
+        REQUIRE(matrix.hasPaths());
+        for (std::size_t i = 0; i < kPoints.size(); ++i) {
+            for (std::size_t j = 0; j < kPoints.size(); ++j) {
+                if (i == kWallPoint || j == kWallPoint || !same_region(i, j)) continue;
+                const Path path = matrix.path(i, j);
+                Cell end = kPoints[i];
+                float cost = 0.0f;
+                for (Direction dir : path) {
+                    end.move(dir);
+                    CHECK_FALSE(maze.at_unchecked(end).wall);
+                    cost += maze.at_unchecked(end).weight;
+                }
+                CHECK(end == kPoints[j]);
+                CHECK(cost == Catch::Approx(matrix.cost(i, j)));
+            }
+        }
+        CHECK(matrix.path(0, kRepeat).empty());
+    }
+
+    SECTION("bad input throws") {
+        DistanceMatrix matrix = maze.distanceMatrix(kPoints);
+        CHECK_THROWS_AS(matrix.path(0, 1), std::logic_error);
+        CHECK_THROWS_AS(matrix.cost(0, kPoints.size()), std::out_of_range);
+        CHECK_THROWS_AS(maze.distanceMatrix({{0, 0}, {16, 0}}), std::out_of_range);
+        CHECK(maze.distanceMatrix({}).size() == 0);
+    }
+}
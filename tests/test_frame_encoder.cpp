@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "maze/maze.hpp"
+
+namespace {
+
+const CellMetaData kWall{true, '#', Color::gray, 1.0f};
+const CellMetaData kPassage{false, '.', Color::white, 1.0f};
+
+Maze open_maze(std::size_t width, std::size_t height) {
+    Maze maze(width, height);
+    for (std::size_t r = 0; r < height; ++r) {
+        for (std::size_t c = 0; c < width; ++c) maze[{r, c}] = kPassage;
+    }
+    return maze;
+}
+
+// Occurrences of `needle` in `text`
+std::size_t count(std::string_view text, std::string_view needle) {
+    std::size_t found = 0;
+    for (std::size_t at = text.find(needle); at != std::string_view::npos;
+         at = text.find(needle, at + 1)) {
+        ++found;
+    }
+    return found;
+}
+
+// Text with every CSI escape sequence removed
+std::string strip_escapes(std::string_view text) {
+    std::string plain;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\033') {
+            while (i < text.size() && !(text[i] >= '@' && text[i] <= '~' && text[i] != '[')) ++i;
+            continue;
+        }
+        plain += text[i];
+    }
+    return plain;
+}
+
+}  // namespace
+
+TEST_CASE("Full encoding", "[frame]") {
+    Maze maze = open_maze(4, 2);
+    maze[{1, 2}] = kWall;
+
+    AnsiFrameEncoder encoder;
+    std::string text(encoder.full(maze));
+
+    SECTION("Colors are written only when they change") {
+        // Row 0 is one color; row 1 switches to the wall and back
+        CHECK(count(text, "\033[38;5;") == 1 + 3);
+        CHECK(count(text, "\033[0m") == 2);
+    }
+
+    SECTION("Glyphs keep the spaced row layout") {
+        CHECK(strip_escapes(text) == ". . . . \n. . # . \n");
+    }
+
+    SECTION("operator<< writes the same text") {
+        std::ostringstream out;
+        out << maze;
+        CHECK(out.str() == text);
+    }
+}
+
+TEST_CASE("Incremental frames", "[frame]") {
+    Maze maze = open_maze(5, 3);
+    AnsiFrameEncoder encoder;
+
+    std::string first(encoder.frame(maze));
+    CHECK(encoder.changedCells() == 15);
+    CHECK(first.starts_with("\033[2J"));
+    CHECK(count(first, "\033[38;5;") == 1);
+
+    SECTION("An unchanged maze sends nothing") {
+        CHECK(encoder.frame(maze).empty());
+        CHECK(encoder.changedCells() == 0);
+    }
+
+    SECTION("One changed cell is addressed and written alone") {
+        maze[{2, 3}] = kWall;
+        std::string next(encoder.frame(maze));
+        CHECK(encoder.changedCells() == 1);
+        CHECK(next == "\033[3;7H\033[38;5;7m# \033[0m");
+    }
+
+    SECTION("Adjacent changes share one cursor move") {
+        maze[{1, 1}] = kWall;
+        maze[{1, 2}] = kWall;
+        std::string next(encoder.frame(maze));
+        CHECK(encoder.changedCells() == 2);
+        CHECK(count(next, "H") == 1);
+        CHECK(strip_escapes(next) == "# # ");
+    }
+
+    SECTION("Touched cells give the same update as a full scan") {
+        maze[{0, 4}] = kWall;
+        const std::vector<Cell> touched{{0, 4}, {2, 0}};
+        std::string next(encoder.frame(maze, touched));
+        CHECK(next == "\033[1;9H\033[38;5;7m# \033[0m");
+        CHECK(encoder.frame(maze).empty());
+    }
+
+    SECTION("Reset and resizes redraw everything") {
+        encoder.reset();
+        CHECK(encoder.frame(maze) == first);
+
+        Maze wider = open_maze(6, 3);
+        encoder.frame(wider);
+        CHECK(encoder.changedCells() == 18);
+    }
+}
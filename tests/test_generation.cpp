@@ -96,3 +96,31 @@ TEST_CASE("Maze generation algorithms produce connected passages", "[generation]
         check_connected_generation(GenerationAlgorithm::Kruskal);
     }
 }
+
+TEST_CASE("Seeded generation is reproducible", "[generation][seed]") {
+    CellMetaData wall{true, '#', Color::red, 1.0f};
+    CellMetaData passage{false, ' ', Color::white, 1.0f};
+
+    for (GenerationAlgorithm algorithm : {GenerationAlgorithm::RecursiveBacktracker,
+             GenerationAlgorithm::Prim, GenerationAlgorithm::Kruskal}) {
+        Maze first(41, 31);
+        Maze second(41, 31);
+        first.generate(algorithm, wall, passage, 2024);
+        second.generate(algorithm, wall, passage, 2024);
+        CHECK(first.fingerprint() == second.fingerprint());
+
+        second.generate(algorithm, wall, passage, 2025);
+        CHECK(first.fingerprint() != second.fingerprint());
+    }
+
+    SECTION("output is pinned across platforms") {
+        // Seeded generation uses no std distributions, so these never change
+        Maze maze(21, 21);
+        maze.generate(GenerationAlgorithm::Kruskal, wall, passage, 7);
+        CHECK(maze.fingerprint() == 0x20a8252fcabf219aULL);
+
+        std::vector<CellMetaData> cells{wall, passage, {false, '~', Color::cyan, 3.0f}};
+        maze.generateRandom(cells, 0.3f, 7);
+        CHECK(maze.fingerprint() == 0x7b3d1a9c8958229bULL);
+    }
+}
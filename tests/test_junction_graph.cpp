@@ -0,0 +1,93 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "maze/index/junction_graph.hpp"
+#include "maze/maze.hpp"
+
+namespace {
+
+const CellMetaData kWall{true, '#', Color::gray, 10.0f};
+const CellMetaData kPassage{false, ' ', Color::white, 1.0f};
+
+// Returns a negative cost if the path leaves the grid or hits a wall
+float walk_cost(const Maze& maze, Cell start, Cell dest, const Path& path) {
+    float total = 0.0f;
+    Cell current = start;
+    for (Direction dir : path) {
+        if (!current.hasDir(dir, maze.getWidth(), maze.getHeight())) return -1.0f;
+        current.move(dir);
+        if (maze.at_unchecked(current).wall) return -1.0f;
+        total += maze.at_unchecked(current).weight;
+    }
+    return current == dest ? total : -1.0f;
+}
+
+}  // namespace
+
+TEST_CASE("JunctionGraph contracts generated mazes", "[junction]") {
+    Maze maze(41, 41);
+    maze.generate(GenerationAlgorithm::RecursiveBacktracker, kWall, kPassage);
+    // Give corridors uneven costs so edge weights matter
+    for (std::size_t r = 0; r < 41; ++r) {
+        for (std::size_t c = 0; c < 41; ++c) {
+            if (!maze.at_unchecked({r, c}).wall) maze[{r, c}].weight = 1.0f + (r * 7 + c) % 5;
+        }
+    }
+
+    JunctionGraph<CellMetaData> graph(maze);
+    std::size_t passages = 0;
+    for (std::size_t r = 0; r < 41; ++r) {
+        for (std::size_t c = 0; c < 41; ++c) {
+            if (!maze.at_unchecked({r, c}).wall) ++passages;
+        }
+    }
+    CHECK(graph.nodeCount() < passages / 2);
+
+    const Cell endpoints[] = {{1, 1}, {39, 39}, {1, 39}, {20, 21}, {21, 20}, {39, 1}};
+    for (Cell start : endpoints) {
+        for (Cell dest : endpoints) {
+            if (start == dest || maze.at_unchecked(start).wall || maze.at_unchecked(dest).wall) {
+                continue;
+            }
+            Path expected = maze.findPath(Algorithm::Dijkstra, start, dest);
+            Path actual = graph.findPath(start, dest);
+            REQUIRE_FALSE(actual.empty());
+            CHECK(walk_cost(maze, start, dest, actual)
+                == Catch::Approx(walk_cost(maze, start, dest, expected)));
+        }
+    }
+}
+
+TEST_CASE("JunctionGraph handles corridors and loops", "[junction]") {
+    SECTION("endpoints on the same corridor") {
+        Maze maze(7, 1);
+        for (std::size_t c = 0; c < 7; ++c) maze[{0, c}] = kPassage;
+        JunctionGraph<CellMetaData> graph(maze);
+        CHECK(graph.nodeCount() == 2);
+        CHECK(graph.edgeCount() == 1);
+
+        Path path = graph.findPath({0, 4}, {0, 2});
+        CHECK(path == Path{Direction::left, Direction::left});
+    }
+
+    SECTION("ring without junctions") {
+        Maze maze(3, 3);
+        for (std::size_t r = 0; r < 3; ++r) {
+            for (std::size_t c = 0; c < 3; ++c) maze[{r, c}] = kPassage;
+        }
+        maze[{1, 1}] = kWall;
+        JunctionGraph<CellMetaData> graph(maze);
+        CHECK(graph.nodeCount() == 1);
+
+        Path path = graph.findPath({0, 1}, {2, 1});
+        CHECK(walk_cost(maze, {0, 1}, {2, 1}, path) == Catch::Approx(4.0f));
+    }
+
+    SECTION("disconnected regions") {
+        Maze maze(5, 1);
+        for (std::size_t c = 0; c < 5; ++c) maze[{0, c}] = kPassage;
+        maze[{0, 2}] = kWall;
+        JunctionGraph<CellMetaData> graph(maze);
+        CHECK(graph.findPath({0, 0}, {0, 4}).empty());
+    }
+}
@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "maze/maze.hpp"
+
+namespace {
+
+float path_cost(const Maze& maze, Cell start, const Path& path) {
+    float total = 0.0f;
+    for (Direction dir : path) {
+        start.move(dir);
+        total += maze.at_unchecked(start).weight;
+    }
+    return total;
+}
+
+void paint_terrain(Maze& maze) {
+    const float weights[] = {1.0f, 2.0f, 4.0f, 6.0f};
+    for (std::size_t r = 0; r < maze.getHeight(); ++r) {
+        for (std::size_t c = 0; c < maze.getWidth(); ++c) {
+            Cell cell{r, c};
+            bool wall = (r % 4 == 2) && (c % 7 != 3);
+            maze[cell] = {wall, wall ? '#' : '.', Color::green,
+                wall ? 10.0f : weights[(r * 5 + c * 3) % 4]};
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("ALT heuristic keeps A* optimal", "[pathfinding][landmarks]") {
+    Maze maze(30, 30);
+    paint_terrain(maze);
+    maze.buildLandmarks(6, 3);
+    REQUIRE(maze.landmarks()->landmarks.size() == 6);
+
+    SearchOptions alt;
+    alt.heuristic = Heuristic::Landmarks;
+    const Cell pairs[][2] = {{{0, 0}, {29, 29}}, {{29, 0}, {0, 29}}, {{13, 4}, {27, 20}}};
+    for (const auto& pair : pairs) {
+        Path expected = maze.findPath(Algorithm::Dijkstra, pair[0], pair[1]);
+        Path actual = maze.findPath(Algorithm::AStar, pair[0], pair[1], alt);
+        REQUIRE_FALSE(actual.empty());
+        CHECK(path_cost(maze, pair[0], actual)
+            == Catch::Approx(path_cost(maze, pair[0], expected)));
+    }
+}
+
+TEST_CASE("ALT heuristic expands fewer cells than Manhattan", "[pathfinding][landmarks]") {
+    Maze maze(30, 30);
+    paint_terrain(maze);
+    maze.buildLandmarks(8);
+
+    std::size_t manhattan = 0;
+    std::size_t landmarks = 0;
+    SearchOptions options;
+    options.on_explore = [&](const Cell&, const std::vector<Cell>&,
+        const std::unordered_set<Cell>&) { ++manhattan; };
+    maze.findPath(Algorithm::AStar, {0, 0}, {29, 29}, options);
+
+    options.heuristic = Heuristic::Landmarks;
+    options.on_explore = [&](const Cell&, const std::vector<Cell>&,
+        const std::unordered_set<Cell>&) { ++landmarks; };
+    maze.findPath(Algorithm::AStar, {0, 0}, {29, 29}, options);
+
+    CHECK(landmarks < manhattan);
+}
+
+TEST_CASE("Landmark tables round-trip through a stream", "[landmarks]") {
+    Maze maze(12, 12);
+    paint_terrain(maze);
+    maze.buildLandmarks(4);
+
+    std::stringstream buffer;
+    maze.landmarks()->save(buffer);
+    auto loaded = std::make_shared<LandmarkTable>(LandmarkTable::load(buffer));
+    CHECK(loaded->landmarks == maze.landmarks()->landmarks);
+    CHECK(loaded->distances == maze.landmarks()->distances);
+    CHECK_NOTHROW(maze.setLandmarks(loaded));
+
+    Maze other(12, 12);
+    CHECK_THROWS_AS(other.setLandmarks(loaded), std::invalid_argument);
+
+    std::stringstream garbage("not a table");
+    CHECK_THROWS_AS(LandmarkTable::load(garbage), std::runtime_error);
+
+    SECTION("a forged header is rejected before allocating") {
+        LandmarkTable forged = *maze.landmarks();
+        forged.width = std::uint64_t{1} << 40;
+        forged.height = std::uint64_t{1} << 30;  // count * width * height wraps
+        std::stringstream wrapped;
+        forged.save(wrapped);
+        CHECK_THROWS_AS(LandmarkTable::load(wrapped), std::runtime_error);
+
+        forged.width = forged.height = 1u << 16;  // 64 GiB claimed, a few KiB present
+        std::stringstream oversized;
+        forged.save(oversized);
+        CHECK_THROWS_AS(LandmarkTable::load(oversized), std::runtime_error);
+    }
+}
+
+TEST_CASE("Landmark heuristic requires tables", "[landmarks]") {
+    Maze maze(5, 5);
+    paint_terrain(maze);
+    SearchOptions options;
+    options.heuristic = Heuristic::Landmarks;
+    CHECK_THROWS_AS(maze.findPath(Algorithm::AStar, {0, 0}, {4, 4}, options), std::logic_error);
+
+    SECTION("an edit drops tables built before it") {
+        maze.buildLandmarks(2);
+        REQUIRE(maze.findPath(Algorithm::AStar, {0, 0}, {4, 4}, options).size() > 0);
+
+        CellMetaData cheaper = std::as_const(maze).at_unchecked({0, 1});
+        cheaper.weight = 1.0f;
+        maze.setCell({0, 1}, cheaper);
+        CHECK(maze.landmarks() == nullptr);
+        CHECK_THROWS_AS(maze.findPath(Algorithm::AStar, {0, 0}, {4, 4}, options), std::logic_error);
+    }
+}
+
+TEST_CASE("Building landmarks keeps the path cache warm", "[landmarks][path-cache]") {
+    Maze maze(16, 16);
+    paint_terrain(maze);
+    maze.cachePaths(16);
+    const Path before = maze.findPath(Algorithm::Dijkstra, {0, 0}, {15, 15});
+    const std::uint64_t version = maze.version();
+
+    maze.buildLandmarks(4);
+    CHECK(maze.version() == version);
+    CHECK(maze.findPath(Algorithm::Dijkstra, {0, 0}, {15, 15}) == before);
+    CHECK(maze.pathCacheStats().hits == 1);
+    CHECK(maze.pathCacheStats().invalidations == 0);
+}
@@ -1,5 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "maze/maze.hpp"
 
@@ -12,6 +14,41 @@ TEST_CASE("Maze construction", "[maze]") {
     }
 }
 
+TEST_CASE("Maze copies", "[maze]") {
+    const CellMetaData wall{true, '#', Color::gray, 1.0f};
+    const CellMetaData passage{false, ' ', Color::white, 1.0f};
+    Maze maze(21, 15);
+    maze.generate(GenerationAlgorithm::Prim, wall, passage, 4);
+    maze.trackComponents();
+    maze.cachePaths(8);
+
+    SECTION("copies own their grid") {
+        Maze copy(maze);
+        CHECK(copy.fingerprint() == maze.fingerprint());
+        CHECK(copy.version() == maze.version());
+        copy.setCell({1, 1}, wall);
+        CHECK_FALSE(maze.at_unchecked({1, 1}).wall);
+        CHECK(copy.fingerprint() != maze.fingerprint());
+    }
+
+    SECTION("copies keep tracking and caching with fresh state") {
+        Maze copy(maze);
+        CHECK(copy.connected({1, 1}, {13, 19}) == maze.connected({1, 1}, {13, 19}));
+        copy.findPath(Algorithm::BFS, {1, 1}, {13, 19});
+        copy.findPath(Algorithm::BFS, {1, 1}, {13, 19});
+        CHECK(copy.pathCacheStats().hits == 1);
+        CHECK(maze.pathCacheStats().hits == 0);
+    }
+
+    SECTION("moves take the grid") {
+        const std::uint64_t fingerprint = maze.fingerprint();
+        Maze moved(std::move(maze));
+        CHECK(moved.fingerprint() == fingerprint);
+        CHECK(moved.getWidth() == 21);
+        CHECK(maze.getWidth() == 0);
+    }
+}
+
 TEST_CASE("Maze bounds checking", "[maze]") {
     Maze maze(10, 10);
 
@@ -55,4 +92,68 @@ TEST_CASE("Maze random generation", "[maze]") {
         std::vector<CellMetaData> zeroCells{zeroWall, zeroPassage};
         CHECK_NOTHROW(maze.generateRandom(zeroCells, 0.5f));
     }
+
+    SECTION("throws when a needed pool is empty") {
+        std::vector<CellMetaData> passages_only{passage};
+        CHECK_THROWS_AS(maze.generateRandom(passages_only, 0.3f), std::invalid_argument);
+        std::vector<CellMetaData> walls_only{wall};
+        CHECK_NOTHROW(maze.generateRandom(walls_only, 1.0f));
+    }
+
+    SECTION("same seed gives the same grid for any thread count") {
+        // Large enough that the fill actually runs in parallel
+        Maze serial(320, 240);
+        Maze parallel(320, 240);
+        CellMetaData mud{false, '~', Color::yellow, 3.0f};
+        std::vector<CellMetaData> pool_a{wall, passage, mud};
+        std::vector<CellMetaData> pool_b{wall, passage, mud};
+        serial.generateRandom(pool_a, 0.3f, 1234, 1);
+        parallel.generateRandom(pool_b, 0.3f, 1234, 4);
+        CHECK(serial.fingerprint() == parallel.fingerprint());
+
+        std::vector<CellMetaData> pool_c{wall, passage, mud};
+        parallel.generateRandom(pool_c, 0.3f, 1235, 4);
+        CHECK(serial.fingerprint() != parallel.fingerprint());
+    }
+}
+
+TEST_CASE("Maze terrain painting", "[maze]") {
+    Maze maze(40, 30);
+    CellMetaData wall{true, '#', Color::red, 1.0f};
+    CellMetaData passage{false, ' ', Color::white, 1.0f};
+    std::vector<CellMetaData> cells{wall, passage};
+    maze.generateRandom(cells, 0.3f, 7);
+
+    std::vector<CellMetaData> terrain{
+        {false, '.', Color::green, 1.0f}, {false, '~', Color::cyan, 4.0f}};
+
+    SECTION("keeps walls and only uses terrain cells for passages") {
+        std::vector<bool> walls;
+        for (std::size_t r = 0; r < 30; ++r)
+            for (std::size_t c = 0; c < 40; ++c) walls.push_back(maze.at_unchecked({r, c}).wall);
+
+        maze.paintTerrain(terrain, 99);
+        std::size_t mismatches = 0;
+        for (std::size_t r = 0; r < 30; ++r) {
+            for (std::size_t c = 0; c < 40; ++c) {
+                const auto& cell = std::as_const(maze).at_unchecked({r, c});
+                mismatches += cell.wall != walls[r * 40 + c];
+                mismatches += !cell.wall && cell.glyph != '.' && cell.glyph != '~';
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+
+    SECTION("zero frequency entries are never drawn") {
+        maze.paintTerrain(terrain, 5, 0, {1.0f, 0.0f});
+        std::size_t drawn = 0;
+        for (std::size_t r = 0; r < 30; ++r)
+            for (std::size_t c = 0; c < 40; ++c)
+                drawn += std::as_const(maze).at_unchecked({r, c}).glyph == '~';
+        CHECK(drawn == 0);
+    }
+
+    SECTION("rejects mismatched frequencies") {
+        CHECK_THROWS_AS(maze.paintTerrain(terrain, 5, 0, {1.0f}), std::invalid_argument);
+    }
 }
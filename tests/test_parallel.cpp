@@ -0,0 +1,34 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+
+#include "maze/core/parallel.hpp"
+
+TEST_CASE("Parallel helpers rethrow worker exceptions", "[parallel]") {
+    SECTION("parallel_for stops handing out items after a failure") {
+        std::atomic<std::size_t> started{0};
+        auto body = [&](std::size_t i) {
+            ++started;
+            if (i == 3) throw std::runtime_error("item failed");
+        };
+        CHECK_THROWS_AS(parallel_for(100000, 4, body), std::runtime_error);
+        CHECK(started.load() < 100000);
+    }
+
+    SECTION("run_team rethrows from any member, not just the caller") {
+        std::atomic<std::size_t> finished{0};
+        auto body = [&](std::size_t id) {
+            if (id == 2) throw std::out_of_range("member failed");
+            ++finished;
+        };
+        CHECK_THROWS_AS(run_team(4, body), std::out_of_range);
+        CHECK(finished.load() == 3);
+    }
+
+    SECTION("bodies that succeed are unaffected") {
+        std::atomic<std::size_t> sum{0};
+        parallel_for(1000, 4, [&](std::size_t i) { sum += i; });
+        CHECK(sum.load() == 1000 * 999 / 2);
+    }
+}
@@ -0,0 +1,143 @@
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+#include "maze/maze.hpp"
+
+namespace {
+
+const CellMetaData kWall{true, '#', Color::gray, 1.0f};
+const CellMetaData kPassage{false, ' ', Color::white, 1.0f};
+const CellMetaData kMud{false, '~', Color::yellow, 5.0f};
+
+// Open 12x12 room with a wall down column 6 that leaves rows 0 and 11 open
+Maze make_room() {
+    Maze maze(12, 12);
+    for (std::size_t r = 0; r < 12; ++r) {
+        for (std::size_t c = 0; c < 12; ++c) {
+            maze.setCell({r, c}, (c == 6 && r != 0 && r != 11) ? kWall : kPassage);
+        }
+    }
+    return maze;
+}
+
+bool crosses(const Path& path, Cell start, Cell target) {
+    if (start == target) return true;
+    for (Direction dir : path) {
+        start.move(dir);
+        if (start == target) return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+TEST_CASE("Path cache serves repeated queries", "[path-cache]") {
+    Maze maze = make_room();
+    maze.cachePaths(4);
+
+    Path first = maze.findPath(Algorithm::AStar, {5, 0}, {5, 11}, SearchOptions{});
+    Path second = maze.findPath(Algorithm::AStar, {5, 0}, {5, 11}, SearchOptions{});
+    CHECK(second == first);
+    CHECK(maze.pathCacheStats().hits == 1);
+    CHECK(maze.pathCacheStats().misses == 1);
+
+    SECTION("algorithm and heuristic are part of the key") {
+        SearchOptions euclidean;
+        euclidean.heuristic = Heuristic::Euclidean;
+        maze.findPath(Algorithm::AStar, {5, 0}, {5, 11}, euclidean);
+        maze.findPath(Algorithm::Dijkstra, {5, 0}, {5, 11}, SearchOptions{});
+        CHECK(maze.pathCacheStats().misses == 3);
+    }
+
+    SECTION("least recently used entries are evicted") {
+        for (std::size_t row = 0; row < 4; ++row) {
+            maze.findPath(Algorithm::BFS, {row, 0}, {row, 1}, SearchOptions{});
+        }
+        CHECK(maze.pathCacheStats().evictions == 1);
+        maze.findPath(Algorithm::AStar, {5, 0}, {5, 11}, SearchOptions{});
+        CHECK(maze.pathCacheStats().hits == 1);  // The A* entry was the oldest
+    }
+
+    SECTION("observed searches bypass the cache") {
+        std::atomic<std::size_t> expansions{0};
+        SearchOptions options;
+        options.expansions = &expansions;
+        maze.findPath(Algorithm::AStar, {5, 0}, {5, 11}, options);
+        CHECK(expansions.load() > 0);
+        CHECK(maze.pathCacheStats().hits == 1);
+    }
+
+    SECTION("budgeted queries bypass the cache") {
+        SearchOptions budget;
+        budget.initial_weight = 5.0f;
+        budget.max_expansions = 20;
+        maze.findPath(Algorithm::ARAStar, {5, 0}, {5, 11}, budget);
+        CHECK(maze.pathCacheStats().misses == 1);
+
+        // Had the cut run been stored, this would be served its unproven path
+        Path full = maze.findPath(Algorithm::ARAStar, {5, 0}, {5, 11}, SearchOptions{});
+        CHECK(full.size() == first.size());
+        CHECK(maze.pathCacheStats().misses == 2);
+    }
+}
+
+TEST_CASE("Path cache invalidates on edits", "[path-cache]") {
+    Maze maze = make_room();
+    maze.cachePaths(16);
+
+    Path top = maze.findPath(Algorithm::Dijkstra, {0, 0}, {0, 11}, SearchOptions{});
+    Path bottom = maze.findPath(Algorithm::Dijkstra, {11, 0}, {11, 11}, SearchOptions{});
+    REQUIRE(top.size() == 11);
+    REQUIRE(bottom.size() == 11);
+    const std::uint64_t version = maze.version();
+
+    SECTION("blocking a cell drops only the paths through it") {
+        maze.setCell({0, 6}, kWall);
+        CHECK(maze.version() > version);
+
+        Path rerouted = maze.findPath(Algorithm::Dijkstra, {0, 0}, {0, 11}, SearchOptions{});
+        CHECK_FALSE(crosses(rerouted, {0, 0}, {0, 6}));
+        CHECK(rerouted.size() > top.size());
+        CHECK(maze.findPath(Algorithm::Dijkstra, {11, 0}, {11, 11}, SearchOptions{}) == bottom);
+        CHECK(maze.pathCacheStats().invalidations == 1);
+        CHECK(maze.pathCacheStats().hits == 1);
+    }
+
+    SECTION("writes through operator[] are journaled too") {
+        maze[{11, 6}] = kMud;
+        Path detour = maze.findPath(Algorithm::Dijkstra, {11, 0}, {11, 11}, SearchOptions{});
+        CHECK(maze.pathCacheStats().invalidations == 1);
+        CHECK(maze.findPath(Algorithm::Dijkstra, {0, 0}, {0, 11}, SearchOptions{}) == top);
+        CHECK(detour.size() >= bottom.size());
+    }
+
+    SECTION("opening a shortcut clears everything") {
+        maze.findPath(Algorithm::Dijkstra, {5, 0}, {5, 11}, SearchOptions{});
+        maze.setCell({5, 6}, kPassage);
+        Path direct = maze.findPath(Algorithm::Dijkstra, {5, 0}, {5, 11}, SearchOptions{});
+        CHECK(direct.size() == 11);
+        CHECK(maze.pathCacheStats().invalidations == 3);
+    }
+
+    SECTION("unreachable results stay cached until something opens") {
+        maze.setCell({0, 6}, kWall);
+        maze.setCell({11, 6}, kWall);
+        CHECK(maze.findPath(Algorithm::BFS, {0, 0}, {0, 11}, SearchOptions{}).empty());
+        CHECK(maze.findPath(Algorithm::BFS, {0, 0}, {0, 11}, SearchOptions{}).empty());
+        CHECK(maze.pathCacheStats().hits == 1);
+
+        maze.setCell({3, 3}, kWall);
+        CHECK(maze.findPath(Algorithm::BFS, {0, 0}, {0, 11}, SearchOptions{}).empty());
+        CHECK(maze.pathCacheStats().hits == 2);
+
+        maze.setCell({0, 6}, kPassage);
+        CHECK_FALSE(maze.findPath(Algorithm::BFS, {0, 0}, {0, 11}, SearchOptions{}).empty());
+    }
+
+    SECTION("regenerating clears the cache") {
+        maze.generate(GenerationAlgorithm::Kruskal, kWall, kPassage, 3);
+        maze.findPath(Algorithm::Dijkstra, {0, 0}, {0, 11}, SearchOptions{});
+        CHECK(maze.pathCacheStats().hits == 0);
+        CHECK(maze.pathCacheStats().invalidations == 2);
+    }
+}
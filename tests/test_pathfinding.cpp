@@ -1,5 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <vector>
 
 #include "maze/maze.hpp"
 
@@ -25,7 +29,7 @@ void block_row(Maze& maze, std::size_t row, std::size_t width) {
     }
 }
 
-float path_cost(Maze& maze, Cell start, const Path& path) {
+float path_cost(const Maze& maze, Cell start, const Path& path) {
     float total = 0.0f;
     Cell current = start;
     for (Direction dir : path) {
@@ -141,3 +145,357 @@ TEST_CASE("Greedy Best-First pathfinding", "[pathfinding][greedy]") {
         CHECK_FALSE(found);
     }
 }
+
+TEST_CASE("Delta-stepping pathfinding", "[pathfinding][delta]") {
+    Maze maze(24, 24);
+    const float weights[] = {1.0f, 2.0f, 4.0f, 6.0f};
+    for (std::size_t r = 0; r < 24; ++r) {
+        for (std::size_t c = 0; c < 24; ++c) {
+            bool wall = (r % 5 == 3) && (c % 6 != 1);
+            maze[{r, c}] = {wall, '.', Color::green, weights[(r * 7 + c * 3) % 4]};
+        }
+    }
+
+    SECTION("matches Dijkstra path cost for several bucket widths") {
+        for (float delta : {0.0f, 1.0f, 2.5f}) {
+            SearchOptions options;
+            options.threads = 4;
+            options.delta = delta;
+            Path expected = maze.findPath(Algorithm::Dijkstra, {0, 0}, {22, 22});
+            Path actual = maze.findPath(Algorithm::DeltaStepping, {0, 0}, {22, 22}, options);
+            REQUIRE_FALSE(actual.empty());
+            CHECK(path_cost(maze, {0, 0}, actual)
+                == Catch::Approx(path_cost(maze, {0, 0}, expected)));
+        }
+    }
+
+    SECTION("cost map matches Dijkstra to every cell") {
+        std::vector<float> costs = maze.costMap({0, 0}, 3, 2.0f);
+        for (std::size_t r = 0; r < 24; r += 3) {
+            for (std::size_t c = 0; c < 24; c += 2) {
+                if (maze.at_unchecked({r, c}).wall || (r == 0 && c == 0)) continue;
+                Path path = maze.findPath(Algorithm::Dijkstra, {0, 0}, {r, c});
+                CHECK(costs[r * 24 + c] == Catch::Approx(path_cost(maze, {0, 0}, path)));
+            }
+        }
+    }
+
+    SECTION("zero-weight cells leave a predecessor tree") {
+        // Equal-cost updates must not re-point cells into a cycle
+        for (bool all_zero : {true, false}) {
+            Maze free_maze(8, 8);
+            for (std::size_t r = 0; r < 8; ++r) {
+                for (std::size_t c = 0; c < 8; ++c) {
+                    const float weight = all_zero || (r + c) % 3 != 0 ? 0.0f : 1.0f;
+                    free_maze[{r, c}] = {false, '.', Color::green, weight};
+                }
+            }
+            Path expected = free_maze.findPath(Algorithm::Dijkstra, {0, 0}, {7, 7});
+            for (std::size_t threads : {1, 4}) {
+                SearchOptions options;
+                options.threads = threads;
+                Path actual = free_maze.findPath(Algorithm::DeltaStepping, {0, 0}, {7, 7}, options);
+                REQUIRE_FALSE(actual.empty());
+                Cell end{0, 0};
+                for (Direction dir : actual) end.move(dir);
+                CHECK(end == Cell{7, 7});
+                CHECK(path_cost(free_maze, {0, 0}, actual)
+                    == Catch::Approx(path_cost(free_maze, {0, 0}, expected)));
+            }
+        }
+    }
+
+    SECTION("returns empty path when blocked") {
+        block_row(maze, 10, 24);
+        CHECK(maze.findPath(Algorithm::DeltaStepping, {0, 0}, {22, 22}).empty());
+        std::vector<float> costs = maze.costMap({0, 0});
+        CHECK(costs[22 * 24 + 22] == std::numeric_limits<float>::infinity());
+    }
+}
+
+TEST_CASE("Parallel BFS pathfinding", "[pathfinding][parallel-bfs]") {
+    SECTION("finds shortest path in open maze") {
+        auto maze = create_open_maze(9, 7);
+        SearchOptions options;
+        options.threads = 3;
+        Path path = maze.findPath(Algorithm::ParallelBFS, {0, 0}, {6, 8}, options);
+        CHECK(path.size() == 14);
+    }
+
+    SECTION("matches BFS levels around obstacles") {
+        // Large enough to trip the switch to bottom-up expansion and back
+        Maze maze(120, 80);
+        std::vector<CellMetaData> cells{
+            {true, '#', Color::red, 1.0f}, {false, ' ', Color::white, 1.0f}};
+        maze.generateRandom(cells, 0.25f);
+        maze[{0, 0}].wall = false;
+
+        std::vector<std::uint32_t> levels = maze.hopMap({0, 0}, 4);
+        for (std::size_t r = 0; r < 80; r += 7) {
+            for (std::size_t c = 0; c < 120; c += 11) {
+                if ((r == 0 && c == 0) || maze.at_unchecked({r, c}).wall) continue;
+                Path path = maze.findPath(Algorithm::BFS, {0, 0}, {r, c});
+                std::uint32_t expected = path.empty()
+                    ? std::numeric_limits<std::uint32_t>::max()
+                    : static_cast<std::uint32_t>(path.size());
+                CHECK(levels[r * 120 + c] == expected);
+
+                Path parallel = maze.findPath(Algorithm::ParallelBFS, {0, 0}, {r, c});
+                CHECK(parallel.size() == path.size());
+            }
+        }
+    }
+
+    SECTION("returns empty path when blocked") {
+        auto maze = create_open_maze(5, 5);
+        block_row(maze, 2, 5);
+        CHECK(maze.findPath(Algorithm::ParallelBFS, {0, 0}, {4, 4}).empty());
+    }
+}
+
+TEST_CASE("Search budgets", "[pathfinding][budget]") {
+    auto maze = create_open_maze(40, 40);
+    block_row(maze, 20, 39);  // Leave the last column open
+
+    auto ends_at = [](Cell start, const Path& path) {
+        for (Direction dir : path) start.move(dir);
+        return start;
+    };
+
+    SECTION("expansion limit returns a partial path for every engine") {
+        for (Algorithm algorithm : kAllAlgorithms) {
+            SearchOptions options;
+            options.threads = 2;
+            options.max_expansions = 50;
+            SearchResult result = maze.search(algorithm, {0, 0}, {39, 39}, options);
+            INFO("algorithm " << static_cast<int>(algorithm));
+            CHECK(result.status == SearchStatus::ExpansionLimit);
+            CHECK(result.expansions >= 50);
+            CHECK(ends_at({0, 0}, result.path) == result.reached);
+            CHECK_FALSE(maze.at_unchecked(result.reached).wall);
+            CHECK(maze.findPath(algorithm, {0, 0}, {39, 39}, options).empty());
+        }
+    }
+
+    SECTION("a raised cancel flag stops the search") {
+        std::atomic<bool> cancel{true};
+        SearchOptions options;
+        options.cancel = &cancel;
+        SearchResult result = maze.search(Algorithm::AStar, {0, 0}, {39, 39}, options);
+        CHECK(result.status == SearchStatus::Cancelled);
+        CHECK(result.expansions == 1);
+    }
+
+    SECTION("a passed deadline stops the search") {
+        SearchOptions options;
+        options.deadline = std::chrono::steady_clock::now();
+        SearchResult result = maze.search(Algorithm::Dijkstra, {0, 0}, {39, 39}, options);
+        CHECK(result.status == SearchStatus::DeadlineExpired);
+    }
+
+    SECTION("a generous budget does not change the result") {
+        SearchOptions options;
+        options.max_expansions = 1'000'000;
+        options.deadline = std::chrono::steady_clock::now() + std::chrono::hours(1);
+        SearchResult result = maze.search(Algorithm::BFS, {0, 0}, {39, 39}, options);
+        CHECK(result.status == SearchStatus::Found);
+        CHECK(result.reached == Cell{39, 39});
+        CHECK(result.path.size() == maze.findPath(Algorithm::BFS, {0, 0}, {39, 39}).size());
+    }
+
+    SECTION("an unreachable destination reports NoPath") {
+        block_row(maze, 20, 40);
+        SearchResult result = maze.search(Algorithm::BFS, {0, 0}, {39, 39});
+        CHECK(result.status == SearchStatus::NoPath);
+        CHECK(result.path.empty());
+    }
+}
+
+TEST_CASE("Exploration traces", "[pathfinding][trace]") {
+    SECTION("steps round-trip through the encoding") {
+        ExplorationTrace trace(1000);
+        std::vector<Cell> cells;
+        for (std::size_t i = 0; i < 2000; ++i) {
+            // Mostly neighbours, with an occasional long jump in either direction
+            Cell cell = i % 97 == 0 ? Cell{(i * 7919) % 1000, (i * 31) % 1000}
+                                    : Cell{i / 40, (i % 40) * 3};
+            cells.push_back(cell);
+            trace.record(cell);
+        }
+        REQUIRE(trace.size() == cells.size());
+        CHECK(trace.bytes() < cells.size() * 3);
+        for (std::size_t step : {0u, 1u, 255u, 256u, 257u, 1000u, 1999u}) {
+            CHECK(trace.at(step) == cells[step]);
+        }
+        std::size_t mismatches = 0;
+        trace.forEach([&](std::size_t step, Cell cell) { mismatches += !(cell == cells[step]); });
+        CHECK(mismatches == 0);
+    }
+
+    SECTION("searches record each expansion once, bypassing the path cache") {
+        auto maze = create_open_maze(30, 20);
+        block_row(maze, 10, 29);
+        maze.cachePaths(4);
+        maze.findPath(Algorithm::AStar, {0, 0}, {19, 29});
+
+        for (Algorithm algorithm : kAllAlgorithms) {
+            ExplorationTrace trace(30);
+            SearchOptions options;
+            options.threads = 2;
+            options.trace = &trace;
+            SearchResult result = maze.search(algorithm, {0, 0}, {19, 29}, options);
+            INFO("algorithm " << static_cast<int>(algorithm));
+            CHECK(trace.size() == result.expansions);
+            CHECK(trace.at(0) == Cell{0, 0});
+
+            trace.clear(30);
+            CHECK_FALSE(maze.findPath(algorithm, {0, 0}, {19, 29}, options).empty());
+            CHECK(trace.size() > 0);
+        }
+        CHECK(maze.pathCacheStats().hits == 0);
+    }
+}
+
+TEST_CASE("ARA* pathfinding", "[pathfinding][ara]") {
+    Maze maze(40, 30);
+    std::vector<CellMetaData> cells{
+        {true, '#', Color::red, 1.0f},
+        {false, '.', Color::white, 1.0f},
+        {false, '~', Color::cyan, 5.0f}};
+    maze.generateRandom(cells, 0.2f, 3);
+    maze[{0, 0}] = cells[1];
+    maze[{29, 39}] = cells[1];
+    Path reference = maze.findPath(Algorithm::Dijkstra, {0, 0}, {29, 39});
+    REQUIRE_FALSE(reference.empty());
+    const float optimal = path_cost(maze, {0, 0}, reference);
+
+    SECTION("converges to the optimal cost without a budget") {
+        SearchResult result = maze.search(Algorithm::ARAStar, {0, 0}, {29, 39});
+        CHECK(result.status == SearchStatus::Found);
+        CHECK(result.bound == 1.0f);
+        CHECK(path_cost(maze, {0, 0}, result.path) == Catch::Approx(optimal));
+    }
+
+    SECTION("an interrupted run keeps its bounded path") {
+        // Weighted passes expand less than plain A*, so its count leaves room for a first path
+        std::size_t first_pass = maze.search(Algorithm::AStar, {0, 0}, {29, 39}).expansions;
+
+        SearchOptions options;
+        options.initial_weight = 5.0f;
+        options.weight_step = 0.25f;
+        options.max_expansions = first_pass;
+        SearchResult result = maze.search(Algorithm::ARAStar, {0, 0}, {29, 39}, options);
+        REQUIRE(result.status == SearchStatus::ExpansionLimit);
+        REQUIRE(result.reached == Cell{29, 39});
+        CHECK(result.bound > 1.0f);
+        CHECK(result.bound <= 5.0f);
+        CHECK(path_cost(maze, {0, 0}, result.path) <= Catch::Approx(optimal * result.bound));
+    }
+
+    SECTION("only reads the maze") {
+        maze.cachePaths(8);
+        const Path cached = maze.findPath(Algorithm::AStar, {0, 0}, {29, 39});
+        const std::uint64_t version = maze.version();
+        maze.search(Algorithm::ARAStar, {0, 0}, {29, 39});
+        CHECK(maze.version() == version);
+        CHECK(maze.findPath(Algorithm::AStar, {0, 0}, {29, 39}) == cached);
+        CHECK(maze.pathCacheStats().hits == 1);
+        CHECK(maze.pathCacheStats().invalidations == 0);
+    }
+
+    SECTION("rejects weights below one") {
+        SearchOptions options;
+        options.initial_weight = 0.5f;
+        CHECK_THROWS_AS(maze.search(Algorithm::ARAStar, {0, 0}, {29, 39}, options),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE("Searches only read the maze", "[pathfinding]") {
+    Maze maze(24, 18);
+    std::vector<CellMetaData> cells{
+        {true, '#', Color::red, 1.0f},
+        {false, '.', Color::white, 1.0f},
+        {false, '~', Color::cyan, 3.0f}};
+    maze.generateRandom(cells, 0.2f, 9);
+    maze[{0, 0}] = cells[1];
+    maze[{17, 23}] = cells[1];
+    maze.trackComponents();
+    maze.cachePaths(8);
+
+    SearchOptions options;
+    options.threads = 2;
+    const std::uint64_t version = maze.version();
+    for (Algorithm algorithm : kAllAlgorithms) {
+        maze.search(algorithm, {0, 0}, {17, 23}, options);
+        CHECK(maze.version() == version);
+    }
+    maze.race({0, 0}, {17, 23}, options);
+    CHECK(maze.version() == version);
+    CHECK(maze.pathCacheStats().invalidations == 0);
+}
+
+TEST_CASE("Racing engines", "[pathfinding][race]") {
+    Maze maze(30, 20);
+    std::vector<CellMetaData> cells{
+        {true, '#', Color::red, 1.0f},
+        {false, '.', Color::white, 1.0f},
+        {false, '~', Color::cyan, 4.0f}};
+    maze.generateRandom(cells, 0.2f);
+    maze[{0, 0}] = cells[1];
+    maze[{19, 29}] = cells[1];
+    Path reference = maze.findPath(Algorithm::Dijkstra, {0, 0}, {19, 29});
+    float optimal = reference.empty() ? std::numeric_limits<float>::infinity()
+                                      : path_cost(maze, {0, 0}, reference);
+
+    SECTION("every engine reports a result") {
+        SearchOptions options;
+        options.threads = 2;
+        auto entries = maze.race({0, 0}, {19, 29}, options);
+        REQUIRE(entries.size() == kAllAlgorithms.size());
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            const auto& entry = entries[i];
+            CHECK(entry.algorithm == kAllAlgorithms[i]);
+            CHECK(entry.finished.load());
+            CHECK(entry.error.empty());
+            CHECK(entry.expansions.load() > 0);
+            CHECK(entry.path.empty() == reference.empty());
+            if (!entry.path.empty()) {
+                CHECK(entry.cost == Catch::Approx(path_cost(maze, {0, 0}, entry.path)));
+                CHECK(entry.cost >= Catch::Approx(optimal));
+            }
+        }
+        for (Algorithm optimal_engine : {Algorithm::Dijkstra, Algorithm::AStar,
+                 Algorithm::ARAStar, Algorithm::DeltaStepping}) {
+            CHECK(entries[static_cast<std::size_t>(optimal_engine)].cost
+                == Catch::Approx(optimal));
+        }
+    }
+
+    SECTION("options a lane would reject throw before any lane starts") {
+        std::vector<RaceEntry> entries(2);
+        entries[0].algorithm = Algorithm::BFS;
+        entries[1].algorithm = Algorithm::ARAStar;
+        SearchOptions options;
+        options.initial_weight = 0.5f;
+        CHECK_THROWS_AS(maze.race({0, 0}, {19, 29}, entries, options), std::invalid_argument);
+
+        options = SearchOptions{};
+        options.heuristic = Heuristic::Landmarks;  // No tables built
+        CHECK_THROWS_AS(maze.race({0, 0}, {19, 29}, entries, options), std::logic_error);
+        CHECK_FALSE(entries[0].finished.load());
+        CHECK(entries[0].expansions.load() == 0);
+    }
+
+    SECTION("expansion counter matches a plain search") {
+        std::atomic<std::size_t> expansions{0};
+        SearchOptions options;
+        options.expansions = &expansions;
+        maze.findPath(Algorithm::AStar, {0, 0}, {19, 29}, options);
+
+        std::vector<RaceEntry> entries(1);
+        entries[0].algorithm = Algorithm::AStar;
+        maze.race({0, 0}, {19, 29}, entries);
+        CHECK(entries[0].expansions.load() == expansions.load());
+    }
+}
@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstddef>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+#include "maze/procedural_maze.hpp"
+
+namespace {
+
+const CellMetaData kWall{true, '#', Color::gray, 1.0f};
+const std::vector<CellMetaData> kTerrain{
+    {false, '.', Color::white, 1.0f}, {false, '~', Color::cyan, 3.0f}};
+
+// Copy a window of the procedural maze into a stored maze
+Maze materialize(const ProceduralMaze& source) {
+    Maze maze(source.getWidth(), source.getHeight());
+    for (std::size_t r = 0; r < source.getHeight(); ++r)
+        for (std::size_t c = 0; c < source.getWidth(); ++c)
+            maze.setCell({r, c}, source.at_unchecked({r, c}));
+    return maze;
+}
+
+std::size_t count_reachable(const ProceduralMaze& maze, Cell start) {
+    std::vector<bool> seen(maze.getWidth() * maze.getHeight(), false);
+    std::queue<Cell> queue;
+    queue.push(start);
+    seen[start.row * maze.getWidth() + start.col] = true;
+    std::size_t count = 0;
+    while (!queue.empty()) {
+        Cell cell = queue.front();
+        queue.pop();
+        ++count;
+        for (std::uint8_t d = 0; d < Direction::COUNT; ++d) {
+            Direction dir = static_cast<Direction>(d);
+            if (!cell.hasDir(dir, maze.getWidth(), maze.getHeight())) continue;
+            Cell next = cell.toward(dir);
+            if (maze.at_unchecked(next).wall || seen[next.row * maze.getWidth() + next.col]) continue;
+            seen[next.row * maze.getWidth() + next.col] = true;
+            queue.push(next);
+        }
+    }
+    return count;
+}
+
+}  // namespace
+
+TEST_CASE("Procedural maze layouts", "[procedural]") {
+    for (ProceduralLayout layout : {ProceduralLayout::BinaryTree, ProceduralLayout::Sidewinder}) {
+        ProceduralMaze maze(41, 33, 77, kWall, kTerrain, layout);
+
+        // A perfect maze on n nodes opens n - 1 links and reaches every passage
+        std::size_t passages = 0;
+        for (std::size_t r = 0; r < 33; ++r)
+            for (std::size_t c = 0; c < 41; ++c) passages += !maze.at_unchecked({r, c}).wall;
+        const std::size_t nodes = 16 * 20;
+        CHECK(passages == nodes + nodes - 1);
+        CHECK(count_reachable(maze, {1, 1}) == passages);
+
+        ProceduralMaze again(41, 33, 77, kWall, kTerrain, layout);
+        ProceduralMaze other(41, 33, 78, kWall, kTerrain, layout);
+        CHECK(materialize(maze).fingerprint() == materialize(again).fingerprint());
+        CHECK(materialize(maze).fingerprint() != materialize(other).fingerprint());
+    }
+}
+
+TEST_CASE("Procedural maze search", "[procedural]") {
+    SECTION("matches searches on the materialized grid") {
+        ProceduralMaze source(51, 41, 3, kWall, kTerrain);
+        Maze stored = materialize(source);
+        for (Cell dest : {Cell{39, 49}, Cell{1, 49}, Cell{21, 25}}) {
+            CHECK(source.findPath(Algorithm::BFS, {1, 1}, dest)
+                == stored.findPath(Algorithm::BFS, {1, 1}, dest));
+            CHECK(source.findPath(Algorithm::AStar, {1, 1}, dest).size()
+                == stored.findPath(Algorithm::AStar, {1, 1}, dest).size());
+        }
+    }
+
+    SECTION("searches a maze far too large to store") {
+        const std::size_t side = std::size_t{1} << 30;
+        ProceduralMaze huge(side, side, 11, kWall, kTerrain);
+        std::atomic<std::size_t> expansions{0};
+        SearchOptions options;
+        options.expansions = &expansions;
+        Path path = huge.findPath(Algorithm::AStar, {1001, 1001}, {1201, 1301}, options);
+        CHECK_FALSE(path.empty());
+        CHECK(expansions.load() < 1000000);
+
+        Cell current{1001, 1001};
+        std::size_t walls_crossed = 0;
+        for (Direction dir : path) {
+            current.move(dir);
+            walls_crossed += huge.at_unchecked(current).wall;
+        }
+        CHECK(walls_crossed == 0);
+        CHECK(current == Cell{1201, 1301});
+    }
+
+    SECTION("rejects engines that need a stored grid") {
+        ProceduralMaze maze(21, 21, 1, kWall, kTerrain);
+        CHECK_THROWS_AS(maze.findPath(Algorithm::Dijkstra, {1, 1}, {19, 19}),
+            std::invalid_argument);
+        CHECK_THROWS_AS(maze.cellAt({21, 0}), std::out_of_range);
+    }
+}
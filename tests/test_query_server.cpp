@@ -0,0 +1,178 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "maze/server/query_server.hpp"
+
+using maze::server::LatencyHistogram;
+using maze::server::QueryServer;
+
+namespace {
+
+bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+Maze make_maze() {
+    Maze maze(41, 31);
+    maze.generate(GenerationAlgorithm::Kruskal, {true, '#', Color::gray, 1.0f},
+        {false, ' ', Color::white, 1.0f}, 8);
+    return maze;
+}
+
+}  // namespace
+
+TEST_CASE("Query server answers path requests", "[server]") {
+    Maze maze = make_maze();
+    maze.cachePaths(16);
+    QueryServer server(maze, 2);
+    const Path expected = maze.search(Algorithm::BFS, {1, 1}, {29, 39}).path;
+
+    std::string response = server.handle(
+        R"({"id":7,"op":"path","algorithm":"bfs","start":[1,1],"dest":[29,39]})");
+    CHECK(response.starts_with(R"({"id":7,"status":"found","length":)"));
+    CHECK(contains(response, "\"length\":" + std::to_string(expected.size())));
+    CHECK(contains(response, "\"path\":\""));
+
+    SECTION("ids are echoed verbatim and paths can be omitted") {
+        response = server.handle(
+            R"({"id":"q-1","algorithm":"astar","start":[1,1],"dest":[29,39],"path":false})");
+        CHECK(response.starts_with(R"({"id":"q-1","status":"found")"));
+        CHECK_FALSE(contains(response, "\"path\""));
+    }
+
+    SECTION("budgets report their status") {
+        response = server.handle(
+            R"({"id":1,"algorithm":"dijkstra","start":[1,1],"dest":[29,39],"max_expansions":3})");
+        CHECK(contains(response, R"("status":"expansion_limit")"));
+        CHECK(contains(response, R"("expansions":3)"));
+    }
+
+    SECTION("thread counts are capped at the core count") {
+        for (const char* algorithm : {"delta", "parallel-bfs"}) {
+            response = server.handle(std::string(R"({"id":8,"algorithm":")") + algorithm
+                + R"(","start":[1,1],"dest":[29,39],"threads":1e9})");
+            CHECK(response.starts_with(R"({"id":8,"status":"found")"));
+        }
+    }
+
+    SECTION("bad requests get errors, not exceptions") {
+        CHECK(contains(server.handle("{not json"), "\"error\":\"Malformed JSON"));
+        CHECK(contains(server.handle(R"({"id":2,"start":[1,1],"dest":[99,1]})"),
+            R"({"id":2,"error":"dest is outside the maze"})"));
+        CHECK(contains(server.handle(R"({"id":3,"algorithm":"teleport","start":[1,1],"dest":[1,1]})"),
+            "Unknown algorithm"));
+        CHECK(contains(server.handle(R"({"id":4,"op":"connected","a":[1,1],"b":[1,3]})"),
+            "trackComponents"));
+        // Deep nesting must fail cleanly rather than exhaust the stack
+        CHECK(contains(server.handle(std::string(1'000'000, '[')), "nesting too deep"));
+        CHECK(contains(server.handle(R"({"id":6,"x":)" + std::string(20, '[') + std::string(20, ']') + "}"),
+            "nesting too deep"));
+    }
+
+    SECTION("stats report per-op latency and cache use") {
+        server.handle(R"({"algorithm":"bfs","start":[1,1],"dest":[29,39]})");
+        std::string stats = server.handle(R"({"id":5,"op":"stats"})");
+        CHECK(contains(stats, R"("path":{"count":2,)"));
+        CHECK(contains(stats, R"("cache":{"hits":1,)"));
+    }
+}
+
+TEST_CASE("Query server pipelines a stream", "[server]") {
+    Maze maze = make_maze();
+    maze.trackComponents();
+    QueryServer server(maze, 3);
+
+    std::ostringstream requests;
+    const std::size_t count = 40;
+    for (std::size_t i = 0; i < count; ++i) {
+        requests << R"({"id":)" << i << R"(,"algorithm":")" << (i % 2 ? "bfs" : "astar")
+                 << R"(","start":[1,1],"dest":[)" << 1 + 2 * (i % 15) << R"(,39]})" << "\n";
+        if (i % 10 == 0) requests << "\n";  // Blank lines are skipped
+    }
+    requests << R"({"id":"c","op":"connected","a":[1,1],"b":[29,39]})" << "\n";
+
+    std::istringstream in(requests.str());
+    std::ostringstream out;
+    server.serve(in, out);
+
+    // Responses arrive in completion order, so match them up by id
+    std::istringstream lines(out.str());
+    std::set<std::string> ids;
+    std::size_t found = 0;
+    for (std::string line; std::getline(lines, line);) {
+        ids.insert(line.substr(6, line.find(',') - 6));
+        found += contains(line, R"("status":"found")");
+        if (line.starts_with(R"({"id":"c")")) CHECK(contains(line, R"("connected":true)"));
+    }
+    CHECK(ids.size() == count + 1);
+    CHECK(found == count);
+}
+
+#ifndef _WIN32
+TEST_CASE("Query server hangs up on runaway socket lines", "[server]") {
+    Maze maze = make_maze();
+    QueryServer server(maze, 1);
+    const std::string path = "/tmp/maze_test_" + std::to_string(::getpid()) + ".sock";
+    std::atomic<bool> stop{false};
+    std::jthread listener([&] { server.serveSocket(path, stop); });
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::copy(path.begin(), path.end(), address.sun_path);
+    const int client = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    REQUIRE(client >= 0);
+    bool connected = false;
+    for (int attempt = 0; attempt < 100 && !connected; ++attempt) {
+        connected = ::connect(client, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+        if (!connected) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(connected);
+
+    // A request followed by a line that never ends; the server stops reading
+    // partway, so the send may fail once it hangs up
+    const std::string request = R"({"id":1,"op":"info"})" "\n";
+    ::send(client, request.data(), request.size(), MSG_NOSIGNAL);
+    const std::string runaway(2 * QueryServer::kMaxLineBytes, 'x');
+    ::send(client, runaway.data(), runaway.size(), MSG_NOSIGNAL);
+
+    std::string received;
+    char chunk[4096];
+    for (ssize_t n; (n = ::recv(client, chunk, sizeof(chunk), 0)) > 0;) {
+        received.append(chunk, static_cast<std::size_t>(n));
+    }
+    ::close(client);
+    stop = true;
+
+    CHECK(contains(received, R"({"id":1,"width":41)"));
+    CHECK(contains(received, R"({"id":null,"error":"Request line exceeds )"));
+}
+#endif
+
+TEST_CASE("Latency histogram percentiles", "[server]") {
+    LatencyHistogram histogram;
+    CHECK(histogram.percentile(0.5) == 0);
+    for (int i = 0; i < 90; ++i) histogram.record(3);      // Bucket [2, 4)
+    for (int i = 0; i < 10; ++i) histogram.record(1000);   // Bucket [512, 1024)
+    CHECK(histogram.count() == 100);
+    CHECK(histogram.percentile(0.5) == 4);
+    CHECK(histogram.percentile(0.9) == 4);
+    CHECK(histogram.percentile(0.99) == 1000);  // Capped at the observed max
+    CHECK(histogram.max() == 1000);
+
+    std::string json;
+    histogram.writeJson(json);
+    CHECK(json.starts_with(R"({"count":100,"p50_us":4,)"));
+}
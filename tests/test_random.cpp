@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "maze/core/alias_table.hpp"
+#include "maze/core/random.hpp"
+
+TEST_CASE("Counter-based random words", "[random]") {
+    SECTION("are a pure function of seed, stream and counter") {
+        CHECK(random_at(42, 0, 7) == random_at(42, 0, 7));
+        CHECK(random_at(42, 0, 7) != random_at(43, 0, 7));
+        CHECK(random_at(42, 0, 7) != random_at(42, 1, 7));
+        CHECK(random_at(42, 0, 7) != random_at(42, 0, 8));
+    }
+
+    SECTION("map to unit floats in [0, 1)") {
+        double sum = 0.0;
+        std::size_t out_of_range = 0;
+        constexpr std::uint64_t kDraws = 100000;
+        for (std::uint64_t i = 0; i < kDraws; ++i) {
+            float u = unit_float(random_at(1, 0, i));
+            out_of_range += u < 0.0f || u >= 1.0f;
+            sum += u;
+        }
+        CHECK(out_of_range == 0);
+        CHECK(sum / kDraws == Catch::Approx(0.5).margin(0.01));
+    }
+}
+
+TEST_CASE("Alias table sampling", "[random][alias]") {
+    SECTION("matches the requested frequencies") {
+        AliasTable table({1.0f, 0.0f, 3.0f, 4.0f});
+        std::vector<std::size_t> counts(table.size(), 0);
+        constexpr std::uint64_t kDraws = 200000;
+        for (std::uint64_t i = 0; i < kDraws; ++i) ++counts[table.sample(random_at(9, 0, i))];
+
+        CHECK(counts[1] == 0);
+        CHECK(counts[0] / double(kDraws) == Catch::Approx(0.125).margin(0.01));
+        CHECK(counts[2] / double(kDraws) == Catch::Approx(0.375).margin(0.01));
+        CHECK(counts[3] / double(kDraws) == Catch::Approx(0.5).margin(0.01));
+    }
+
+    SECTION("falls back to uniform when all weights are zero") {
+        AliasTable table({0.0f, 0.0f});
+        std::size_t first = 0;
+        for (std::uint64_t i = 0; i < 10000; ++i) first += table.sample(random_at(3, 0, i)) == 0;
+        CHECK(first / 10000.0 == Catch::Approx(0.5).margin(0.03));
+    }
+
+    SECTION("rejects empty pools and negative weights") {
+        CHECK_THROWS_AS(AliasTable({}), std::invalid_argument);
+        CHECK_THROWS_AS(AliasTable({1.0f, -1.0f}), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Sequential counter generator", "[random]") {
+    SECTION("bounded draws stay in range and cover it evenly") {
+        CounterRng rng(11);
+        std::vector<std::size_t> counts(6, 0);
+        std::size_t out_of_range = 0;
+        for (int i = 0; i < 60000; ++i) {
+            std::uint64_t value = rng.bounded(6);
+            if (value >= 6) {
+                ++out_of_range;
+            } else {
+                ++counts[value];
+            }
+        }
+        CHECK(out_of_range == 0);
+        for (std::size_t count : counts) CHECK(count / 60000.0 == Catch::Approx(1.0 / 6).margin(0.01));
+    }
+
+    SECTION("shuffle is a seeded permutation") {
+        std::vector<int> a{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        std::vector<int> b = a;
+        CounterRng first(5);
+        CounterRng second(5);
+        first.shuffle(a.begin(), a.end());
+        second.shuffle(b.begin(), b.end());
+        CHECK(a == b);
+
+        std::vector<int> sorted = a;
+        std::sort(sorted.begin(), sorted.end());
+        CHECK(sorted == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    }
+}
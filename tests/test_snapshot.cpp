@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "maze/snapshot.hpp"
+
+namespace {
+
+const CellMetaData kWall{true, '#', Color::gray, 1.0f};
+const CellMetaData kPassage{false, ' ', Color::white, 1.0f};
+
+Maze make_maze(std::size_t width, std::size_t height) {
+    Maze maze(width, height);
+    maze.generate(GenerationAlgorithm::RecursiveBacktracker, kWall, kPassage, 21);
+    return maze;
+}
+
+}  // namespace
+
+TEST_CASE("Snapshots mirror the maze", "[snapshot]") {
+    Maze maze = make_maze(151, 99);  // Partial tiles on both edges
+    MazeSnapshot snapshot(maze);
+
+    CHECK(snapshot.getWidth() == 151);
+    CHECK(snapshot.getHeight() == 99);
+    CHECK(snapshot.version() == maze.version());
+    CHECK(snapshot.tileCount() == 3 * 2);
+    std::size_t mismatches = 0;
+    for (std::size_t r = 0; r < 99; ++r)
+        for (std::size_t c = 0; c < 151; ++c)
+            mismatches += snapshot.at_unchecked({r, c}).wall != maze.at_unchecked({r, c}).wall;
+    CHECK(mismatches == 0);
+    CHECK_THROWS_AS(snapshot.cellAt({99, 0}), std::out_of_range);
+
+    for (Algorithm algorithm : {Algorithm::BFS, Algorithm::Dijkstra, Algorithm::AStar}) {
+        SearchResult expected = maze.search(algorithm, {1, 1}, {97, 149});
+        SearchResult actual = snapshot.search(algorithm, {1, 1}, {97, 149});
+        CHECK(actual.status == SearchStatus::Found);
+        CHECK(actual.path.size() == expected.path.size());
+    }
+    CHECK_THROWS_AS(snapshot.search(Algorithm::DFS, {1, 1}, {97, 149}), std::invalid_argument);
+}
+
+TEST_CASE("Snapshot editors copy on write", "[snapshot]") {
+    Maze maze = make_maze(200, 130);
+    auto base = std::make_shared<const MazeSnapshot>(maze);
+    MazeEditor editor(base);
+
+    editor.set({1, 1}, kWall);
+    editor.set({2, 3}, kWall);  // Same tile
+    editor.set({129, 199}, kWall);
+    CHECK(editor.copiedTiles() == 2);
+    CHECK(editor.at({1, 1}).wall);
+    CHECK_FALSE(base->at_unchecked({1, 1}).wall);  // The base never changes
+
+    auto next = editor.commit();
+    CHECK(next->version() == base->version() + 1);
+    CHECK(next->sharedTiles(*base) == base->tileCount() - 2);
+    CHECK(next->at_unchecked({1, 1}).wall);
+    CHECK(editor.copiedTiles() == 0);
+
+    // Committed tiles are shared again, so the next edit copies afresh
+    editor.set({1, 1}, kPassage);
+    auto third = editor.commit();
+    CHECK(next->at_unchecked({1, 1}).wall);
+    CHECK_FALSE(third->at_unchecked({1, 1}).wall);
+    CHECK(third->version() == base->version() + 2);
+    CHECK_THROWS_AS(editor.set({130, 0}, kWall), std::out_of_range);
+}
+
+TEST_CASE("Maze store publishes while readers search", "[snapshot]") {
+    Maze maze = make_maze(129, 129);
+    MazeStore store(maze);
+    const std::uint64_t first = store.current()->version();
+
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> searches{0};
+    std::atomic<std::size_t> inconsistent{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                // Each snapshot is all-or-nothing: either both edits or neither
+                auto snapshot = store.current();
+                bool a = snapshot->at_unchecked({0, 0}).wall == kPassage.wall;
+                bool b = snapshot->at_unchecked({128, 128}).wall == kPassage.wall;
+                if (a != b) ++inconsistent;
+                snapshot->findPath(Algorithm::BFS, {1, 1}, {127, 127});
+                ++searches;
+            }
+        });
+    }
+
+    for (int round = 0; round < 20; ++round) {
+        const CellMetaData& value = round % 2 == 0 ? kPassage : kWall;
+        store.update([&](MazeEditor& editor) {
+            editor.set({0, 0}, value);
+            editor.set({128, 128}, value);
+        });
+    }
+    while (searches.load() < 4) std::this_thread::yield();
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    CHECK(inconsistent.load() == 0);
+    CHECK(store.current()->version() == first + 20);
+}
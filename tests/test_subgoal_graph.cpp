@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "maze/index/subgoal_graph.hpp"
+#include "maze/maze.hpp"
+
+namespace {
+
+const CellMetaData kWall{true, '#', Color::gray, 1.0f};
+const CellMetaData kPassage{false, ' ', Color::white, 1.0f};
+
+// Follow `path` from `start`, failing on walls; returns the cell it ends on
+Cell walk(const Maze& maze, Cell start, const Path& path) {
+    for (Direction dir : path) {
+        REQUIRE(start.hasDir(dir, maze.getWidth(), maze.getHeight()));
+        start.move(dir);
+        REQUIRE_FALSE(maze.at_unchecked(start).wall);
+    }
+    return start;
+}
+
+}  // namespace
+
+TEST_CASE("SubgoalGraph paths are as short as BFS", "[subgoal]") {
+    for (float density : {0.1f, 0.25f, 0.4f}) {
+        Maze maze(48, 36);
+        std::vector<CellMetaData> cells{kWall, kPassage};
+        maze.generateRandom(cells, density, 11);
+        SubgoalGraph<CellMetaData> graph(maze, 4);
+        REQUIRE(graph.nodeCount() > 0);
+
+        std::vector<Cell> open;
+        for (std::size_t r = 0; r < 36; ++r) {
+            for (std::size_t c = 0; c < 48; ++c) {
+                if (!maze.at_unchecked({r, c}).wall) open.push_back({r, c});
+            }
+        }
+        for (std::size_t i = 0; i < 60; ++i) {
+            const Cell start = open[(i * 7919) % open.size()];
+            const Cell dest = open[(i * 104729 + 13) % open.size()];
+            const Path expected = maze.findPath(Algorithm::BFS, start, dest);
+            const Path path = graph.findPath(start, dest);
+            CHECK(path.size() == expected.size());
+            if (!path.empty()) CHECK(walk(maze, start, path) == dest);
+        }
+    }
+}
+
+TEST_CASE("SubgoalGraph expands far fewer nodes than A* on open maps", "[subgoal]") {
+    Maze maze(128, 128);
+    std::vector<CellMetaData> cells{kWall, kPassage};
+    maze.generateRandom(cells, 0.1f, 3);
+    maze[{0, 0}] = kPassage;
+    maze[{127, 127}] = kPassage;
+    SubgoalGraph<CellMetaData> graph(maze);
+
+    std::atomic<std::size_t> astar_expansions{0};
+    SearchOptions options;
+    options.expansions = &astar_expansions;
+    const Path expected = maze.findPath(Algorithm::AStar, {0, 0}, {127, 127}, options);
+
+    std::size_t expansions = 0;
+    const Path path = graph.findPath({0, 0}, {127, 127}, &expansions);
+    REQUIRE(path.size() == expected.size());
+    CHECK(walk(maze, {0, 0}, path) == Cell{127, 127});
+    CHECK(expansions * 10 < astar_expansions.load());
+}
+
+TEST_CASE("SubgoalGraph handles direct, unreachable and blocked queries", "[subgoal]") {
+    // Open 7x5 room split by a full wall at column 3
+    Maze maze(7, 5);
+    for (std::size_t r = 0; r < 5; ++r) {
+        for (std::size_t c = 0; c < 7; ++c) maze[{r, c}] = c == 3 ? kWall : kPassage;
+    }
+    SubgoalGraph<CellMetaData> graph(maze);
+    CHECK(graph.nodeCount() == 0);
+    CHECK(graph.edgeCount() == 0);
+
+    const Path direct = graph.findPath({0, 0}, {4, 2});
+    CHECK(direct.size() == 6);
+    CHECK(walk(maze, {0, 0}, direct) == Cell{4, 2});
+    CHECK(graph.findPath({0, 0}, {0, 6}).empty());
+    CHECK(graph.findPath({0, 0}, {0, 3}).empty());
+    CHECK(graph.findPath({0, 0}, {9, 9}).empty());
+    CHECK(graph.findPath({2, 2}, {2, 2}).empty());
+}
+
+TEST_CASE("SubgoalGraph routes around a corner through subgoals", "[subgoal]") {
+    // A wall stub leaves a gap in row 0; the path must bend at its end
+    Maze maze(5, 5);
+    for (std::size_t r = 0; r < 5; ++r) {
+        for (std::size_t c = 0; c < 5; ++c) maze[{r, c}] = kPassage;
+    }
+    for (std::size_t r = 1; r < 5; ++r) maze[{r, 2}] = kWall;
+    SubgoalGraph<CellMetaData> graph(maze);
+    CHECK(graph.nodeCount() == 2);
+    CHECK(graph.edgeCount() == 1);
+
+    std::size_t expansions = 0;
+    const Path path = graph.findPath({4, 0}, {4, 4}, &expansions);
+    CHECK(path.size() == 12);
+    CHECK(walk(maze, {4, 0}, path) == Cell{4, 4});
+    CHECK(expansions > 0);
+}
+
+TEST_CASE("SubgoalGraph rejects non-uniform weights", "[subgoal]") {
+    Maze maze(4, 4);
+    for (std::size_t r = 0; r < 4; ++r) {
+        for (std::size_t c = 0; c < 4; ++c) maze[{r, c}] = kPassage;
+    }
+    maze[{2, 2}].weight = 3.0f;
+    CHECK_THROWS_AS(SubgoalGraph<CellMetaData>(maze), std::invalid_argument);
+}
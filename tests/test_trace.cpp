@@ -0,0 +1,73 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "maze/maze.hpp"
+
+namespace {
+
+// The tracer is process-wide; leave it disabled and empty for other tests
+struct TracerGuard {
+    TracerGuard() { Tracer::instance().clear(); }
+    ~TracerGuard() {
+        Tracer::instance().enable(false);
+        Tracer::instance().clear();
+    }
+};
+
+std::string export_trace() {
+    std::ostringstream out;
+    Tracer::instance().writeChromeTrace(out);
+    return out.str();
+}
+
+}  // namespace
+
+TEST_CASE("Disabled tracing records nothing", "[trace]") {
+    TracerGuard guard;
+    {
+        MAZE_TRACE_SCOPE("test", "ignored");
+    }
+    CHECK(Tracer::instance().counts().first == 0);
+}
+
+#ifndef MAZE_NO_TRACING
+TEST_CASE("Enabled tracing exports Chrome trace events", "[trace]") {
+    TracerGuard guard;
+    Tracer::instance().enable();
+
+    {
+        MAZE_TRACE_SCOPE("test", "outer");
+        MAZE_TRACE_SCOPE("test", "inner \"quoted\"");
+    }
+    std::thread worker([] {
+        Tracer::instance().nameThread("worker");
+        MAZE_TRACE_SCOPE("test", "on worker");
+    });
+    worker.join();
+
+    CHECK(Tracer::instance().counts().first == 3);
+    std::string json = export_trace();
+    CHECK(json.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    CHECK(json.find("\"name\":\"outer\"") != std::string::npos);
+    CHECK(json.find("\"name\":\"inner \\\"quoted\\\"\"") != std::string::npos);
+    CHECK(json.find("\"ph\":\"X\"") != std::string::npos);
+    CHECK(json.find("\"args\":{\"name\":\"worker\"}") != std::string::npos);
+
+    Tracer::instance().clear();
+    CHECK(Tracer::instance().counts().first == 0);
+}
+
+TEST_CASE("Search engines emit trace scopes", "[trace]") {
+    TracerGuard guard;
+    Maze maze(8, 8);
+    for (std::size_t r = 0; r < 8; ++r) {
+        for (std::size_t c = 0; c < 8; ++c) maze[{r, c}] = {false, ' ', Color::white, 1.0f};
+    }
+
+    Tracer::instance().enable();
+    maze.findPath(Algorithm::Dijkstra, {0, 0}, {7, 7});
+    CHECK(export_trace().find("\"name\":\"Dijkstra\"") != std::string::npos);
+}
+#endif
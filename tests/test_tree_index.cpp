@@ -0,0 +1,75 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <stdexcept>
+
+#include "maze/index/tree_index.hpp"
+#include "maze/maze.hpp"
+
+namespace {
+
+const CellMetaData kWall{true, '#', Color::gray, 10.0f};
+const CellMetaData kPassage{false, ' ', Color::white, 1.0f};
+
+float path_cost(const Maze& maze, Cell start, const Path& path) {
+    float total = 0.0f;
+    for (Direction dir : path) {
+        start.move(dir);
+        total += maze.at_unchecked(start).weight;
+    }
+    return total;
+}
+
+}  // namespace
+
+TEST_CASE("TreeIndex answers queries on perfect mazes", "[tree]") {
+    for (auto algorithm : {GenerationAlgorithm::RecursiveBacktracker,
+             GenerationAlgorithm::Prim, GenerationAlgorithm::Kruskal}) {
+        Maze maze(31, 25);
+        maze.generate(algorithm, kWall, kPassage);
+        for (std::size_t r = 0; r < 25; ++r) {
+            for (std::size_t c = 0; c < 31; ++c) {
+                if (!maze.at_unchecked({r, c}).wall) maze[{r, c}].weight = 1.0f + (r + 3 * c) % 4;
+            }
+        }
+        REQUIRE(TreeIndex<CellMetaData>::isPerfect(maze));
+        TreeIndex<CellMetaData> index(maze);
+
+        const Cell endpoints[] = {{1, 1}, {23, 29}, {1, 29}, {23, 1}, {11, 15}};
+        for (Cell a : endpoints) {
+            for (Cell b : endpoints) {
+                if (a == b) continue;
+                Path expected = maze.findPath(Algorithm::BFS, a, b);
+                Path actual = index.findPath(a, b);
+                REQUIRE(actual.size() == expected.size());
+                CHECK(index.distance(a, b) == expected.size());
+
+                Cell end = a;
+                for (Direction dir : actual) end.move(dir);
+                CHECK(end == b);
+                CHECK(*index.cost(a, b) == Catch::Approx(path_cost(maze, a, actual)));
+            }
+        }
+    }
+}
+
+TEST_CASE("TreeIndex rejects cycles and separates trees", "[tree]") {
+    SECTION("open room has cycles") {
+        Maze maze(3, 3);
+        for (std::size_t r = 0; r < 3; ++r) {
+            for (std::size_t c = 0; c < 3; ++c) maze[{r, c}] = kPassage;
+        }
+        CHECK_FALSE(TreeIndex<CellMetaData>::isPerfect(maze));
+        CHECK_THROWS_AS(TreeIndex<CellMetaData>(maze), std::invalid_argument);
+    }
+
+    SECTION("disconnected corridors") {
+        Maze maze(5, 1);
+        for (std::size_t c = 0; c < 5; ++c) maze[{0, c}] = kPassage;
+        maze[{0, 2}] = kWall;
+        TreeIndex<CellMetaData> index(maze);
+        CHECK(index.connected({0, 0}, {0, 1}));
+        CHECK_FALSE(index.connected({0, 0}, {0, 4}));
+        CHECK_FALSE(index.distance({0, 0}, {0, 2}).has_value());
+        CHECK(index.findPath({0, 0}, {0, 4}).empty());
+    }
+}